@@ -14,12 +14,16 @@ public class HideAndSeekWithAI : ModuleRules
 			"CoreUObject",
 			"Engine",
 			"InputCore",
+			"NavigationSystem",
 			"Slate",
 			"SlateCore",
 			"UMG",
 		});
 
-		PrivateDependencyModuleNames.AddRange(new string[] {  });
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Json",
+			"TraceLog",
+		});
 
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
@@ -3,4 +3,53 @@
 #include "HideAndSeekWithAI.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, HideAndSeekWithAI, "HideAndSeekWithAI" );
+#include <GenericTeamAgentInterface.h>
+#include <Misc/CoreDelegates.h>
+
+#include "TLogWriter.h"
+#include "TStats.h"
+#include "TStyle.h"
+#include "TTeamComponent.h"
+
+/** The game module; sets up the module wide services. */
+class FHideAndSeekWithAIModule : public FDefaultGameModuleImpl
+{
+public:
+    virtual void StartupModule() override
+    {
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FTStats::EndFrame);
+
+        FTStyle::Initialize();
+
+        FGenericTeamId::SetAttitudeSolver(&UTTeamComponent::GetAttitude);
+
+#if defined ( HIDEANDSEEKWITHAI_LOGGING )
+        FTLogWriter::Startup();
+        LogOnScreenHandle =
+                FCoreDelegates::OnEndFrame.AddStatic(&FTLogWriter::FlushOnScreen);
+#endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
+    }
+
+    virtual void ShutdownModule() override
+    {
+#if defined ( HIDEANDSEEKWITHAI_LOGGING )
+        FCoreDelegates::OnEndFrame.Remove(LogOnScreenHandle);
+        FTLogWriter::Shutdown();
+#endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
+
+        FGenericTeamId::ResetAttitudeSolver();
+
+        FTStyle::Shutdown();
+
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    }
+
+private:
+    /** Rolls the frame counters over at the end of every frame. */
+    FDelegateHandle EndFrameHandle;
+
+    /** Shows the log entries drained during the frame on screen. */
+    FDelegateHandle LogOnScreenHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FHideAndSeekWithAIModule, HideAndSeekWithAI, "HideAndSeekWithAI" );
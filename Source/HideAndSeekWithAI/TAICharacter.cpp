@@ -4,12 +4,13 @@
 #include <Components/ArrowComponent.h>
 #include <Components/BoxComponent.h>
 #include <Components/CapsuleComponent.h>
-#include <Components/WidgetComponent.h>
+#include <Kismet/GameplayStatics.h>
 #include <UObject/Class.h>
 #include <UObject/ConstructorHelpers.h>
 
 #include "TAICharacterMovementComponent.h"
-#include "TAIStateWidget.h"
+#include "TGameState.h"
+#include "TStats.h"
 #include "TTeamComponent.h"
 
 ATAICharacter::ATAICharacter(const FObjectInitializer& ObjectInitializer)
@@ -45,28 +46,23 @@ ATAICharacter::ATAICharacter(const FObjectInitializer& ObjectInitializer)
     Team->SetTeamNumber(1);
 
     AIState = EAIState::Idle;
-
-    AIStateWidget = ObjectInitializer.CreateDefaultSubobject<UWidgetComponent>(
-                this, TEXT("AIStateWidget"));
-    AIStateWidget->SetupAttachment(RootComponent);
-    AIStateWidget->SetCanEverAffectNavigation(false);
-    AIStateWidget->SetWidgetSpace(EWidgetSpace::Screen);
-    AIStateWidget->SetWidgetClass(UTAIStateWidget::StaticClass());
-    AIStateWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 125.0f));
 }
 
 void ATAICharacter::BeginPlay()
 {
     Super::BeginPlay();
 
-    UTAIStateWidget* AIStateWidgetObject =
-            Cast<UTAIStateWidget>(AIStateWidget->GetUserWidgetObject());
-    checkf(AIStateWidgetObject, TEXT("FATAL: not an UTAIStateWidget instance!"));
-
-    AIStateWidgetObject->SetAICharacter(this);
-
     TouchSenseTrigger->OnComponentBeginOverlap.AddDynamic(
                 this, &ATAICharacter::OnOverlapBegins);
+
+    ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(GetWorld()));
+    if (GameState)
+    {
+        GameState->RegisterBot(this);
+    }
+
+    FTStats::AddBotsInAIState(AIState, 1);
 }
 
 void ATAICharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -75,6 +71,15 @@ void ATAICharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
     TouchSenseTrigger->OnComponentBeginOverlap.RemoveDynamic(
                 this, &ATAICharacter::OnOverlapBegins);
+
+    ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(GetWorld()));
+    if (GameState)
+    {
+        GameState->UnregisterBot(this);
+    }
+
+    FTStats::AddBotsInAIState(AIState, -1);
 }
 
 void ATAICharacter::OnOverlapBegins(
@@ -98,3 +103,21 @@ void ATAICharacter::OnOverlapBegins(
         }
     }
 }
+
+void ATAICharacter::SetAIState(const EAIState& State)
+{
+    if (AIState == State)
+    {
+        return;
+    }
+
+    if (HasActorBegunPlay())
+    {
+        FTStats::AddBotsInAIState(AIState, -1);
+        FTStats::AddBotsInAIState(State, 1);
+    }
+
+    AIState = State;
+
+    OnAIStateChanged.Broadcast(this, AIState);
+}
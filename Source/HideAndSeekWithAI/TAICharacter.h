@@ -8,7 +8,6 @@
 #include "TAICharacter.generated.h"
 
 class UBoxComponent;
-class UWidgetComponent;
 
 class UTTeamComponent;
 
@@ -22,21 +21,22 @@ public:
     /** This delegate fires when the bot gets touched by another actor. */
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FOnTouchedByActorDelegate, AActor*, InstigatorActor );
 
+    /** This native delegate fires when the bot's state changes. */
+    DECLARE_MULTICAST_DELEGATE_TwoParams( FOnAIStateChangedDelegate, ATAICharacter*, const EAIState& );
+
 public:
     /** This delegate fires when the bot gets touched by another actor. */
     UPROPERTY(BlueprintAssignable, Category = "Perception")
     FOnTouchedByActorDelegate OnTouchedByActor;
 
+    /** This delegate fires when the bot's state changes. */
+    FOnAIStateChangedDelegate OnAIStateChanged;
+
 protected:
     /** This box trigger is used in order to detect touch events. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
     UBoxComponent* TouchSenseTrigger;
 
-    /** This in game UMG-based widget is used to indicate the current state of
-     *  the bot. e.g., suspicious, alerted, invesitgating, etc. */
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
-    UWidgetComponent* AIStateWidget;
-
 private:
     /** Holds the original bot's spawn point. */
     UPROPERTY(Transient)
@@ -79,9 +79,7 @@ public:
         return AIState;
     }
 
-    /** Sets the bot's current state. */
-    FORCEINLINE void SetAIState(const EAIState& State)
-    {
-        AIState = State;
-    }
+    /** Sets the bot's current state and notifies the OnAIStateChanged
+     *  listeners if it changes. */
+    void SetAIState(const EAIState& State);
 };
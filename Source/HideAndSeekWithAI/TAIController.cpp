@@ -21,7 +21,9 @@
 #include "TLog.h"
 #include "TPickup.h"
 #include "TPlayerCharacter.h"
+#include "TStats.h"
 #include "TTeamComponent.h"
+#include "TTrace.h"
 
 static constexpr uint64 TLOG_KEY_AI_TARGET_PERCEPTION_UPDATED = TLOG_KEY_AI + 1;
 static constexpr uint64 TLOG_KEY_AI_PERCEPTION_UPDATED = TLOG_KEY_AI_TARGET_PERCEPTION_UPDATED + 1;
@@ -56,7 +58,7 @@ ATAIController::ATAIController(
     SightSense->LoseSightRadius = 2000.0f;
     SightSense->PeripheralVisionAngleDegrees = 70.0f;
     SightSense->DetectionByAffiliation.bDetectEnemies = true;
-    SightSense->DetectionByAffiliation.bDetectFriendlies = true;
+    SightSense->DetectionByAffiliation.bDetectFriendlies = false;
     SightSense->DetectionByAffiliation.bDetectNeutrals = true;
     SightSense->AutoSuccessRangeFromLastSeenLocation = -1.0f;
     SightSense->SetMaxAge(10.0f);
@@ -95,12 +97,16 @@ ATAIController::ATAIController(
 void ATAIController::OnTargetPerceptionUpdated(
         AActor* Actor, FAIStimulus Stimulus)
 {
+    TSTAT_PERCEPTION_SCOPE(STAT_HideAndSeek_OnTargetPerceptionUpdated);
+
     ATAICharacter* AICharacter = Cast<ATAICharacter>(GetCharacter());
     checkf(AICharacter, TEXT("FATAL: not HideAndSeekWithAI's AI character!"));
 
     TLOG_AI_LOG(TLOG_KEY_AI_TARGET_PERCEPTION_UPDATED,
                 TEXT("OnTargetPerceptionUpdated"), Cast<AActor>(AICharacter));
 
+    TTRACE_PERCEPTION_STIMULUS(AICharacter, Actor, Stimulus);
+
     if (!Stimulus.WasSuccessfullySensed())
     {
         return;
@@ -123,36 +129,27 @@ void ATAIController::OnTargetPerceptionUpdated(
             return;
         }
 
-        if (!UTTeamComponent::AreEnemies(AICharacter, Actor))
+        ATCharacter* OtherCharacter = Cast<ATCharacter>(Actor);
+
+        if (!UTTeamComponent::AreEnemies(AICharacter->GetTeamNumber(),
+                                         OtherCharacter->GetTeamNumber()))
         {
             return;
         }
 
-        ATCharacter* OtherCharacter = Cast<ATCharacter>(Actor);
         if (TargetPawn == OtherCharacter)
         {
             return;
         }
 
-        TLOG_AI_WARNING(TLOG_KEY_AI_SIGHT_SENSE, TEXT("Sight sense"),
-                        Cast<AActor>(AICharacter), Actor);
-
         SetTargetPawn(OtherCharacter);
     }
     else { /// Auditory
-        if (TargetPawn)
+        if (!CanChaseNoise(Actor))
         {
             return;
         }
 
-        if (!Actor->IsA<ATPlayerCharacter>())
-        {
-            TLOG_AI_WARNING(TLOG_KEY_AI_SIGHT_SENSE, TEXT("Hearing actor!"),
-                            Cast<AActor>(AICharacter), Actor);
-
-            return;
-        }
-
         FString PickupItemName(
                     Stimulus.Tag.ToString().Replace(
                         *FString::Printf(TEXT("%s_"), TEXT(T_NOISE)),
@@ -171,11 +168,6 @@ void ATAIController::OnTargetPerceptionUpdated(
                     FString ItemName(UKismetSystemLibrary::GetDisplayName(
                                          Item));
 
-                    TLOG_AI_WARNING(TLOG_KEY_AI_SIGHT_SENSE,
-                                    TEXT("Hearing sense; comparing..."),
-                                    Cast<AActor>(AICharacter),
-                                    ItemName, PickupItemName);
-
                     if (ItemName == PickupItemName)
                     {
                         PickupItem = Item;
@@ -194,16 +186,49 @@ void ATAIController::OnTargetPerceptionUpdated(
             return;
         }
 
-        TLOG_AI_WARNING(TLOG_KEY_AI_SIGHT_SENSE, TEXT("Hearing sense"),
-                        Cast<AActor>(AICharacter), Actor, PickupItemName);
-
         SetTargetItem(PickupItem);
     }
 }
 
+void ATAIController::OnNoiseHeard(AActor* Source, AActor* Instigator)
+{
+    if (!CanChaseNoise(Instigator))
+    {
+        return;
+    }
+
+    ATPickup* PickupItem = Cast<ATPickup>(Source);
+    if (!PickupItem)
+    {
+        return;
+    }
+
+    SetTargetItem(PickupItem);
+}
+
+bool ATAIController::CanChaseNoise(AActor* Instigator) const
+{
+    if (TargetPawn)
+    {
+        return false;
+    }
+
+    if (!Instigator || !Instigator->IsA<ATPlayerCharacter>())
+    {
+        TLOG_AI_WARNING(TLOG_KEY_AI_SIGHT_SENSE, TEXT("Hearing actor!"),
+                        Cast<AActor>(GetCharacter()), Instigator);
+
+        return false;
+    }
+
+    return true;
+}
+
 void ATAIController::OnPerceptionUpdated(
         const TArray<AActor*>& UpdatedActors)
 {
+    TSTAT_PERCEPTION_SCOPE(STAT_HideAndSeek_OnPerceptionUpdated);
+
     ATAICharacter* AICharacter = Cast<ATAICharacter>(GetCharacter());
     checkf(AICharacter, TEXT("FATAL: not HideAndSeekWithAI's AI character!"));
 
@@ -258,6 +283,9 @@ void ATAIController::OnPossess(APawn* InPawn)
 
     SetTargetControlRotation(GetControlRotation());
 
+    /* The perception system filters the friendlies out by this team. */
+    SetGenericTeamId(AICharacter->GetGenericTeamId());
+
     Perception->OnTargetPerceptionUpdated.AddDynamic(
                 this, &ATAIController::OnTargetPerceptionUpdated);
     Perception->OnPerceptionUpdated.AddDynamic(
@@ -287,6 +315,19 @@ void ATAIController::OnUnPossess()
     }
 }
 
+void ATAIController::SetGenericTeamId(const FGenericTeamId& NewTeamId)
+{
+    if (GetGenericTeamId() == NewTeamId)
+    {
+        return;
+    }
+
+    Super::SetGenericTeamId(NewTeamId);
+
+    /* The perception system caches the listener's team. */
+    Perception->RequestStimuliListenerUpdate();
+}
+
 void ATAIController::BeginPlay()
 {
     Super::BeginPlay();
@@ -299,6 +340,8 @@ void ATAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void ATAIController::Tick(float DeltaSeconds)
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_AIControllerTick);
+
     Super::Tick(DeltaSeconds);
 
     DrawFOV();
@@ -316,10 +359,15 @@ void ATAIController::OnMoveCompleted(
         const FPathFollowingResult& Result)
 {
     Super::OnMoveCompleted(RequestId, Result);
+
+    TTRACE_MOVE_COMPLETED(GetPawn(), RequestId.GetID(),
+                          static_cast<uint8>(Result.Code));
 }
 
 void ATAIController::OnIdleTimerTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_IdleTick);
+
     if (!IsIdle())
     {
         return;
@@ -331,6 +379,8 @@ void ATAIController::OnIdleTimerTick()
 
 void ATAIController::OnSuspiciousTimerTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_SuspiciousTick);
+
     if (!IsGameOnGoing())
     {
         StopMovement();
@@ -368,6 +418,8 @@ void ATAIController::OnSuspiciousTimerTick()
 
 void ATAIController::OnAlertedTimerTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_AlertedTick);
+
     if (!IsGameOnGoing())
     {
         StopMovement();
@@ -404,6 +456,8 @@ void ATAIController::OnAlertedTimerTick()
 
 void ATAIController::OnInvestigationTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_InvestigationTick);
+
     if (!IsGameOnGoing())
     {
         StopMovement();
@@ -441,6 +495,8 @@ void ATAIController::OnInvestigationTick()
 
 void ATAIController::OnCarryingItemTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_CarryingItemTick);
+
     if (!IsGameOnGoing())
     {
         StopMovement();
@@ -473,6 +529,8 @@ void ATAIController::OnCarryingItemTick()
 
 void ATAIController::OnGoingBackTick()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_GoingBackTick);
+
     if (!IsGameOnGoing())
     {
         StopMovement();
@@ -534,6 +592,9 @@ void ATAIController::OnTouchedByActor(AActor* InstigatorActor)
 
 bool ATAIController::IsPlayerInSight() const
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_IsPlayerInSight);
+    TSTAT_INC_FRAME_COUNTER(SightChecks);
+
     if (TargetPawn)
     {
         return true;
@@ -623,6 +684,16 @@ bool ATAIController::IsPlayerInSafeDistance() const
     return (PlayerDistance > MaxSightDistance);
 }
 
+float ATAIController::GetSightRadius() const
+{
+    return SightSense->SightRadius;
+}
+
+float ATAIController::GetPeripheralVisionAngle() const
+{
+    return SightSense->PeripheralVisionAngleDegrees;
+}
+
 void ATAIController::SetTargetPawn(ATCharacter *OtherCharacter)
 {
     if (TargetPawn == OtherCharacter)
@@ -764,7 +835,7 @@ void ATAIController::BeIdle()
 
     ClearAllTimers();
 
-    AICharacter->SetAIState(EAIState::Idle);
+    ChangeAIState(AICharacter, EAIState::Idle);
 
     ResetIdleTimer();
 }
@@ -781,7 +852,7 @@ void ATAIController::GetSuspicious()
 
     ClearAllTimers();
 
-    AICharacter->SetAIState(EAIState::Suspicious);
+    ChangeAIState(AICharacter, EAIState::Suspicious);
     AICharacter->GetCharacterMovement()->MaxWalkSpeed =
             ChasingWalkSpeed * SuspiciousWalkSpeedRatio;
 
@@ -803,7 +874,7 @@ void ATAIController::BeAlerted()
 
     ClearAllTimers();
 
-    AICharacter->SetAIState(EAIState::Alerted);
+    ChangeAIState(AICharacter, EAIState::Alerted);
     AICharacter->GetCharacterMovement()->MaxWalkSpeed = ChasingWalkSpeed;
 
     GetWorldTimerManager().SetTimer(
@@ -824,7 +895,7 @@ void ATAIController::Investigate()
 
     ClearAllTimers();
 
-    AICharacter->SetAIState(EAIState::Investigating);
+    ChangeAIState(AICharacter, EAIState::Investigating);
     RemainingInvestigationTimes = UKismetMathLibrary::RandomIntegerInRange(
                 MinInvestigationTimes, MaxInvestigationTimes);
 
@@ -856,7 +927,7 @@ void ATAIController::CarryItem()
 
     AICharacter->PickupItem(TargetItem);
 
-    AICharacter->SetAIState(EAIState::CarryingItem);
+    ChangeAIState(AICharacter, EAIState::CarryingItem);
     AICharacter->GetCharacterMovement()->MaxWalkSpeed =
             ChasingWalkSpeed * CarryingItemWalkSpeedRatio;
 
@@ -878,7 +949,7 @@ void ATAIController::GoBack()
 
     ClearAllTimers();
 
-    AICharacter->SetAIState(EAIState::GoingBack);
+    ChangeAIState(AICharacter, EAIState::GoingBack);
     AICharacter->GetCharacterMovement()->MaxWalkSpeed =
             ChasingWalkSpeed * GoingBackWalkSpeedRatio;
 
@@ -888,8 +959,18 @@ void ATAIController::GoBack()
                 GoingBackTickInterval, true, -1.0f);
 }
 
+void ATAIController::ChangeAIState(ATAICharacter* AICharacter,
+                                   const EAIState& State)
+{
+    TTRACE_AI_STATE_CHANGE(AICharacter, AICharacter->GetAIState(), State);
+
+    AICharacter->SetAIState(State);
+}
+
 void ATAIController::DrawFOV()
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_DrawFOV);
+
     ATAICharacter *AICharacter = Cast<ATAICharacter>(this->GetCharacter());
     if (!AICharacter)
     {
@@ -987,6 +1068,9 @@ void ATAIController::DoRandomTurn()
 EPathFollowingRequestResult::Type ATAIController::MoveToTargetLocation(
         const FVector& Location)
 {
+    TSTAT_AI_SCOPE(STAT_HideAndSeek_MoveToTargetLocation);
+    TSTAT_INC_FRAME_COUNTER(PathRequests);
+
     SetTargetControlRotation(Location);
 
     EPathFollowingRequestResult::Type Result =
@@ -996,21 +1080,13 @@ EPathFollowingRequestResult::Type ATAIController::MoveToTargetLocation(
     ATAICharacter* AICharacter = Cast<ATAICharacter>(GetCharacter());
     checkf(AICharacter, TEXT("FATAL: not HideAndSeekWithAI's AI character!"));
 
-    switch (Result)
+    TTRACE_MOVE_REQUEST(AICharacter, Location, static_cast<uint8>(Result));
+
+    if (Result == EPathFollowingRequestResult::Failed)
     {
-    case EPathFollowingRequestResult::RequestSuccessful:
-        TLOG_AI_WARNING(TLOG_KEY_AI_MOVEMENT, TEXT("Moving toward location!"),
-                        Cast<AActor>(AICharacter), Location);
-        break;
-    case EPathFollowingRequestResult::AlreadyAtGoal:
-        TLOG_AI_WARNING(TLOG_KEY_AI_MOVEMENT, TEXT("Already at goal!"),
-                        Cast<AActor>(AICharacter), Location);
-        break;
-    case EPathFollowingRequestResult::Failed:
         TLOG_AI_WARNING(TLOG_KEY_AI_MOVEMENT,
                         TEXT("Moving toward location has failed!"),
                         Cast<AActor>(AICharacter), Location);
-        break;
     }
 
     return Result;
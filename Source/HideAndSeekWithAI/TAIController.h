@@ -7,6 +7,8 @@
 #include <Perception/AIPerceptionTypes.h>
 #include <UObject/ObjectMacros.h>
 
+#include "HideAndSeekWithAI.h"
+
 #include "TAIController.generated.h"
 
 class AActor;
@@ -15,6 +17,7 @@ class UAIPerceptionComponent;
 class UAISenseConfig_Hearing;
 class UAISenseConfig_Sight;
 
+class ATAICharacter;
 class ATCharacter;
 class ATPickup;
 
@@ -177,6 +180,11 @@ protected:
     virtual void OnPossess(APawn* InPawn) override;
     virtual void OnUnPossess() override;
 
+public:
+    /** Sets the team of the bot and updates its perception listener. */
+    virtual void SetGenericTeamId(const FGenericTeamId& NewTeamId) override;
+
+protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
@@ -218,7 +226,21 @@ public:
      *  if the player is in a safe distance the bot cannot see them. */
     bool IsPlayerInSafeDistance() const;
 
+    /** Returns the maximum distance the bot is able to see. */
+    float GetSightRadius() const;
+
+    /** Returns the bot's peripheral vision half angle in degrees. */
+    float GetPeripheralVisionAngle() const;
+
+    /** Called when the bot hears a thrown item; the bot goes after the item
+     *  if the player threw it and the bot is not chasing anyone. */
+    void OnNoiseHeard(AActor* Source, AActor* Instigator);
+
 protected:
+    /** Determines whether the bot goes after a noise or not; only the noises
+     *  of the player get chased, and only while not chasing anyone. */
+    bool CanChaseNoise(AActor* Instigator) const;
+
     /** Sets the current target pawn to track. */
     void SetTargetPawn(ATCharacter* OtherCharacter);
 
@@ -262,6 +284,9 @@ protected:
     void GoBack();
 
 private:
+    /** Switches the bot to a new AI state. */
+    void ChangeAIState(ATAICharacter* AICharacter, const EAIState& State);
+
     /** Draw the bot's current FOV. */
     void DrawFOV();
 
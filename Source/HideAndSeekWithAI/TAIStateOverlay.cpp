@@ -0,0 +1,207 @@
+#include "TAIStateOverlay.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Engine/LocalPlayer.h>
+#include <Engine/World.h>
+#include <Fonts/FontMeasure.h>
+#include <Framework/Application/SlateApplication.h>
+#include <GameFramework/PlayerController.h>
+#include <HAL/IConsoleManager.h>
+#include <Rendering/DrawElements.h>
+#include <Rendering/SlateRenderer.h>
+#include <SceneView.h>
+#include <Styling/SlateTypes.h>
+#include <UnrealClient.h>
+
+#include "TAICharacter.h"
+#include "TGameState.h"
+#include "THUD.h"
+#include "TStats.h"
+#include "TStyle.h"
+
+/** Where the markers sit relative to the bots' locations. */
+static const FVector MARKER_OFFSET(0.0f, 0.0f, 125.0f);
+
+static TAutoConsoleVariable<int32> CVarAIStateMarkers(
+        TEXT("t.AI.StateMarkers"),
+        1,
+        TEXT("Shows the AI state markers above the bots.\n"
+             " 0: off\n"
+             " 1: on"),
+        ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAIStateMarkerDistance(
+        TEXT("t.AI.StateMarkerDistance"),
+        5000.0f,
+        TEXT("Hides the AI state markers of the bots farther away from the"
+             " camera than this many centimeters; 0 means unlimited."),
+        ECVF_Default);
+
+void STAIStateOverlay::Construct(const FArguments& InArgs)
+{
+    OwnerHUD = InArgs._OwnerHUD;
+
+    const ATHUD* HUD = OwnerHUD.Get();
+    checkf(HUD, TEXT("FATAL: the AI state overlay needs an owner HUD!"));
+
+    const FTextBlockStyle& TextStyle =
+            FTStyle::Get().GetWidgetStyle<FTextBlockStyle>(
+                FTStyle::AI_STATE_MARKER);
+    Font = TextStyle.Font;
+    ShadowOffset = TextStyle.ShadowOffset;
+
+    const TSharedRef<FSlateFontMeasure> FontMeasure =
+            FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+
+    for (uint8 State = 0; State < UE_ARRAY_COUNT(MarkerStyles); ++State)
+    {
+        const FTAIStateMarkerStyle& Style =
+                HUD->GetAIStateMarkerStyle(static_cast<EAIState>(State));
+
+        FMarkerStyle& MarkerStyle = MarkerStyles[State];
+        MarkerStyle.Text = Style.Text.ToString();
+        MarkerStyle.Color = Style.Color;
+        MarkerStyle.ShadowColor = Style.ShadowColor;
+        MarkerStyle.Size = FontMeasure->Measure(MarkerStyle.Text, Font);
+    }
+
+    SetVisibility(EVisibility::HitTestInvisible);
+}
+
+int32 STAIStateOverlay::OnPaint(const FPaintArgs& Args,
+                                const FGeometry& AllottedGeometry,
+                                const FSlateRect& MyCullingRect,
+                                FSlateWindowElementList& OutDrawElements,
+                                int32 LayerId, const FWidgetStyle& InWidgetStyle,
+                                bool bParentEnabled) const
+{
+    TSTAT_SCOPE(STAT_HideAndSeek_AIStateOverlay);
+
+    (void)Args;
+    (void)MyCullingRect;
+
+    ProjectMarkers(AllottedGeometry);
+
+    const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled)
+            ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+    const FLinearColor& Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+    /* All the shadows go on one layer and all the texts on the next one, so
+     * the renderer batches them together. */
+    for (const FMarker& Marker : Markers)
+    {
+        const FMarkerStyle& MarkerStyle = MarkerStyles[Marker.State];
+        const FVector2D TopLeft = Marker.Position - MarkerStyle.Size * 0.5f;
+
+        FSlateDrawElement::MakeText(
+                    OutDrawElements, LayerId,
+                    AllottedGeometry.ToPaintGeometry(
+                        TopLeft + ShadowOffset, MarkerStyle.Size),
+                    MarkerStyle.Text, Font, DrawEffects,
+                    MarkerStyle.ShadowColor * Tint);
+
+        FSlateDrawElement::MakeText(
+                    OutDrawElements, LayerId + 1,
+                    AllottedGeometry.ToPaintGeometry(TopLeft, MarkerStyle.Size),
+                    MarkerStyle.Text, Font, DrawEffects,
+                    MarkerStyle.Color * Tint);
+    }
+
+    return LayerId + 1;
+}
+
+FVector2D STAIStateOverlay::ComputeDesiredSize(
+        float LayoutScaleMultiplier) const
+{
+    (void)LayoutScaleMultiplier;
+
+    return FVector2D::ZeroVector;
+}
+
+void STAIStateOverlay::ProjectMarkers(const FGeometry& AllottedGeometry) const
+{
+    Markers.Reset();
+
+    const ATHUD* HUD = OwnerHUD.Get();
+    if (!HUD || !HUD->PlayerOwner
+            || CVarAIStateMarkers.GetValueOnGameThread() == 0)
+    {
+        return;
+    }
+
+    const ULocalPlayer* LocalPlayer = HUD->PlayerOwner->GetLocalPlayer();
+    if (!LocalPlayer || !LocalPlayer->ViewportClient)
+    {
+        return;
+    }
+
+    const UWorld* World = HUD->GetWorld();
+    const ATGameState* GameState =
+            World ? World->GetGameState<ATGameState>() : nullptr;
+    if (!GameState)
+    {
+        return;
+    }
+
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport,
+                                        eSSP_FULL, ProjectionData))
+    {
+        return;
+    }
+
+    const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+    const FVector2D ViewOrigin(ViewRect.Min);
+    const FVector2D ViewSize(ViewRect.Width(), ViewRect.Height());
+
+    /* The projection is in viewport pixels; the overlay is in Slate units. */
+    const float InverseScale = 1.0f / AllottedGeometry.Scale;
+
+    const float MaxDistance = CVarAIStateMarkerDistance.GetValueOnGameThread();
+    const float MaxDistanceSquared = MaxDistance > 0.0f
+            ? FMath::Square(MaxDistance) : TNumericLimits<float>::Max();
+
+    const TArray<ATAICharacter*>& Bots = GameState->GetBots();
+    Markers.Reserve(Bots.Num());
+
+    for (const ATAICharacter* Bot : Bots)
+    {
+        if (!Bot || Bot->IsHidden())
+        {
+            continue;
+        }
+
+        const FVector Location = Bot->GetActorLocation() + MARKER_OFFSET;
+        if (FVector::DistSquared(Location, ProjectionData.ViewOrigin)
+                > MaxDistanceSquared)
+        {
+            continue;
+        }
+
+        const FPlane Projected =
+                ViewProjection.TransformFVector4(FVector4(Location, 1.0f));
+
+        /* Behind the camera. */
+        if (Projected.W <= KINDA_SMALL_NUMBER)
+        {
+            continue;
+        }
+
+        const float InverseW = 1.0f / Projected.W;
+        const float X = Projected.X * InverseW;
+        const float Y = Projected.Y * InverseW;
+
+        /* Off the screen. */
+        if (X < -1.0f || X > 1.0f || Y < -1.0f || Y > 1.0f)
+        {
+            continue;
+        }
+
+        const FVector2D Pixel(ViewOrigin.X + (0.5f + X * 0.5f) * ViewSize.X,
+                              ViewOrigin.Y + (0.5f - Y * 0.5f) * ViewSize.Y);
+
+        Markers.Add({ Pixel * InverseScale,
+                      static_cast<uint8>(Bot->GetAIState()) });
+    }
+}
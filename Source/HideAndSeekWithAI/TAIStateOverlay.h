@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <Fonts/SlateFontInfo.h>
+#include <Math/Color.h>
+#include <Math/Vector2D.h>
+#include <UObject/WeakObjectPtrTemplates.h>
+#include <Widgets/DeclarativeSyntaxSupport.h>
+#include <Widgets/SLeafWidget.h>
+
+#include "HideAndSeekWithAI.h"
+
+class ATHUD;
+
+/** Draws the AI state markers of all the bots on top of the game viewport.
+ *  Every paint projects all the bots registered with the game state through a
+ *  single view projection matrix, culls the ones behind the camera, off the
+ *  screen or too far away, and draws the rest as text elements in the same
+ *  paint call; so, there are no per-bot widgets, layouts or projections. */
+class HIDEANDSEEKWITHAI_API STAIStateOverlay : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(STAIStateOverlay)
+    {  }
+
+    SLATE_ARGUMENT(TWeakObjectPtr<ATHUD>, OwnerHUD);
+
+    SLATE_END_ARGS (  )
+
+    /* Constructs the widget. */
+    void Construct(const FArguments& InArgs);
+
+public:
+    virtual int32 OnPaint(const FPaintArgs& Args,
+                          const FGeometry& AllottedGeometry,
+                          const FSlateRect& MyCullingRect,
+                          FSlateWindowElementList& OutDrawElements,
+                          int32 LayerId, const FWidgetStyle& InWidgetStyle,
+                          bool bParentEnabled) const override;
+
+    virtual FVector2D ComputeDesiredSize(
+            float LayoutScaleMultiplier) const override;
+
+private:
+    /** The look of the marker of a single AI state, measured once. */
+    struct FMarkerStyle
+    {
+        FString Text;
+        FLinearColor Color;
+        FLinearColor ShadowColor;
+        FVector2D Size;
+    };
+
+    /** A marker to draw, in the local space of the overlay. */
+    struct FMarker
+    {
+        FVector2D Position;
+        uint8 State;
+    };
+
+private:
+    /** The game HUD that owns this widget. */
+    TWeakObjectPtr<ATHUD> OwnerHUD;
+
+    /** The font of all the markers. */
+    FSlateFontInfo Font;
+
+    /** Where the marker shadows sit relative to the markers. */
+    FVector2D ShadowOffset;
+
+    /** The marker styles of all the AI states. */
+    FMarkerStyle MarkerStyles[static_cast<uint8>(EAIState::GoingBack) + 1];
+
+    /** The markers of the last paint; kept around to reuse the memory. */
+    mutable TArray<FMarker> Markers;
+
+private:
+    /** Projects the bots that pass the culling into Markers. */
+    void ProjectMarkers(const FGeometry& AllottedGeometry) const;
+};
@@ -0,0 +1,21 @@
+#include "TBenchmarkSettings.h"
+#include "HideAndSeekWithAI.h"
+
+UTBenchmarkSettings::UTBenchmarkSettings(
+        const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    Map = TEXT("/Game/HideAndSeekWithAI/Maps/HideAndSeekRoom");
+    Seed = 1;
+    WarmupFrames = 120;
+    SampleFrames = 600;
+    LoadTimeout = 120.0f;
+    ThrowsPerFrame = 4;
+    DefaultTolerance = 0.15f;
+}
+
+float UTBenchmarkSettings::GetTolerance(const FString& Metric) const
+{
+    const float* Tolerance = Tolerances.Find(Metric);
+    return Tolerance ? *Tolerance : DefaultTolerance;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Containers/Map.h>
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <UObject/Object.h>
+#include <UObject/ObjectMacros.h>
+
+#include "TBenchmarkSettings.generated.h"
+
+/** Settings and stored baselines of the automated performance benchmarks.
+ *  Running the benchmarks with '-TBenchmarkUpdateBaselines' records the
+ *  measured values as the new baselines into DefaultGame.ini; a metric
+ *  without a baseline gets recorded the same way and passes. */
+UCLASS(config=Game, defaultconfig)
+class HIDEANDSEEKWITHAI_API UTBenchmarkSettings : public UObject
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /** The map the benchmarks run on. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    FString Map;
+
+    /** The layout seed, so all the runs measure the very same layout. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    int32 Seed;
+
+    /** Frames to wait after the map has been loaded before measuring. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    int32 WarmupFrames;
+
+    /** Frames to measure per benchmark. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    int32 SampleFrames;
+
+    /** Seconds to wait for a map to load before giving up. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    float LoadTimeout;
+
+    /** Number of items thrown per frame during the throw storm. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    int32 ThrowsPerFrame;
+
+    /** The allowed relative regression, e.g. 0.15 means up to 15% worse than
+     *  the baseline. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    float DefaultTolerance;
+
+    /** Per metric overrides of the default tolerance. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    TMap<FString, float> Tolerances;
+
+    /** The stored baselines by metric name. */
+    UPROPERTY(config, EditAnywhere, Category = "Benchmark")
+    TMap<FString, float> Baselines;
+
+public:
+    /** Returns the allowed relative regression of a metric. */
+    float GetTolerance(const FString& Metric) const;
+};
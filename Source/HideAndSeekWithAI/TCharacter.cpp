@@ -50,6 +50,32 @@ ATCharacter::ATCharacter(const FObjectInitializer& ObjectInitializer)
 
     Team = ObjectInitializer.CreateDefaultSubobject<UTTeamComponent>(
                 this, TEXT("Team"));
+    TeamId = FGenericTeamId(Team->GetTeamNumber());
+}
+
+void ATCharacter::PostInitializeComponents()
+{
+    Super::PostInitializeComponents();
+
+    /* Picks up the team number set on the component in the editor. */
+    TeamId = FGenericTeamId(Team->GetTeamNumber());
+}
+
+void ATCharacter::SetGenericTeamId(const FGenericTeamId& NewTeamId)
+{
+    TeamId = NewTeamId;
+
+    if (Team && Team->GetTeamNumber() != NewTeamId.GetId())
+    {
+        Team->SetTeamNumber(NewTeamId.GetId());
+    }
+
+    IGenericTeamAgentInterface* TeamAgent =
+            Cast<IGenericTeamAgentInterface>(GetController());
+    if (TeamAgent && TeamAgent->GetGenericTeamId() != NewTeamId)
+    {
+        TeamAgent->SetGenericTeamId(NewTeamId);
+    }
 }
 
 void ATCharacter::PickupItem(ATPickup* Pickup)
@@ -73,9 +99,7 @@ void ATCharacter::DropItem()
     if (HasAnyItems())
     {
         Item->DetachFromCharacter(this);
-        Item->GetMesh()->AddImpulse(
-                    GetControlRotation().Vector().GetSafeNormal() * 100.0f,
-                    NAME_None, true);
+        Item->Launch(GetControlRotation().Vector().GetSafeNormal() * 100.0f);
         Item = nullptr;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GameFramework/Character.h>
+#include <GenericTeamAgentInterface.h>
 #include <UObject/ObjectMacros.h>
 
 #include "TCharacter.generated.h"
@@ -14,7 +15,8 @@ class ATPickup;
 
 /** Base class for all characters in this game, e.g. players and bots. */
 UCLASS(Abstract, BlueprintType, config=Game)
-class HIDEANDSEEKWITHAI_API ATCharacter : public ACharacter
+class HIDEANDSEEKWITHAI_API ATCharacter : public ACharacter,
+        public IGenericTeamAgentInterface
 {
     GENERATED_UCLASS_BODY()
 
@@ -35,7 +37,28 @@ protected:
     UPROPERTY(Transient)
     ATPickup* Item;
 
+private:
+    /** The team number of the team component, cached; answers the team
+     *  queries and the perception system without any component lookup. */
+    FGenericTeamId TeamId;
+
 public:
+    /** Returns the team number. */
+    FORCEINLINE uint8 GetTeamNumber() const
+    {
+        return TeamId.GetId();
+    }
+
+    /** Sets the team of the character, its team component and the controller
+     *  possessing it. */
+    virtual void SetGenericTeamId(const FGenericTeamId& NewTeamId) override;
+
+    /** Returns the team of the character. */
+    virtual FGenericTeamId GetGenericTeamId() const override
+    {
+        return TeamId;
+    }
+
     /** Get the attach point for pickup items. */
     FORCEINLINE UArrowComponent* GetItemAttachPoint() const
     {
@@ -69,4 +92,7 @@ public:
 
     /** Determines whether the character is moving or not. */
     bool IsMoving() const;
+
+protected:
+    virtual void PostInitializeComponents() override;
 };
@@ -1,9 +1,11 @@
 #include "TGameInstance.h"
 #include "HideAndSeekWithAI.h"
 
+#include <GameFramework/GameModeBase.h>
 #include <Kismet/GameplayStatics.h>
 
 #include "TLog.h"
+#include "TStats.h"
 
 UTGameInstance::UTGameInstance(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -65,5 +67,17 @@ void UTGameInstance::LoadLevel(
 
 void UTGameInstance::RestartCurrentLevel()
 {
-    LoadLevel(GetWorld()->GetName(), true);
+    /* Keep the map options, e.g. the number of bots and the layout seed, for
+     * the next match. */
+    FString Options;
+    const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+    if (GameMode)
+    {
+        Options = GameMode->OptionsString;
+        Options.RemoveFromStart(TEXT("?"));
+    }
+
+    FTStats::RestartRequestTime = FPlatformTime::Seconds();
+
+    LoadLevel(GetWorld()->GetName(), true, Options);
 }
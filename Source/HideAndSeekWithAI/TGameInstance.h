@@ -45,6 +45,7 @@ public:
     void LoadLevel(const TSoftObjectPtr<UWorld>& Level,
                    bool bAbsolute = true, FString Options = FString(TEXT("")));
 
-    /** Restart the current level and reload everything. */
+    /** Restart the current level and reload everything. The current map
+     *  options are passed on to the restarted level. */
     void RestartCurrentLevel();
 };
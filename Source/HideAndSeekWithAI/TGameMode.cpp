@@ -18,9 +18,11 @@
 #include "TLog.h"
 #include "TObstacle.h"
 #include "TPickup.h"
+#include "TPlayerAgentController.h"
 #include "TPlayerCharacter.h"
 #include "TPlayerController.h"
 #include "TSpawnArea.h"
+#include "TStats.h"
 
 static constexpr uint8 MAX_SPAWN_RETRIES = static_cast<uint8>(100);
 
@@ -95,6 +97,54 @@ ATGameMode::ATGameMode(const FObjectInitializer& ObjectInitializer)
 
     MatchRestartInterval = 10;
     MatchRestartTimerTicks = 0;
+
+    PlayerAgentClass = ATPlayerAgentController::StaticClass();
+    bUsePlayerAgent = false;
+
+    bEnsureSafeStart = true;
+
+    SpawnStream.GenerateNewSeed();
+}
+
+void ATGameMode::InitGame(const FString& MapName, const FString& Options,
+                          FString& ErrorMessage)
+{
+    Super::InitGame(MapName, Options, ErrorMessage);
+
+    if (bUsePlayerAgent
+            || UGameplayStatics::HasOption(Options, TEXT("PlayerAgent")))
+    {
+        if (PlayerAgentClass)
+        {
+            PlayerControllerClass = PlayerAgentClass;
+        }
+        else
+        {
+            TLOG_ERROR(TLOG_KEY_GENERIC,
+                       "ERROR: player agent class has not been set!");
+        }
+    }
+
+    if (UGameplayStatics::HasOption(Options, TEXT("Bots")))
+    {
+        NumberOfBots = FMath::Max(0, UGameplayStatics::GetIntOption(
+                                      Options, TEXT("Bots"), NumberOfBots));
+    }
+
+    if (UGameplayStatics::HasOption(Options, TEXT("Seed")))
+    {
+        SpawnStream.Initialize(UGameplayStatics::GetIntOption(
+                                   Options, TEXT("Seed"), 0));
+    }
+
+    if (UGameplayStatics::HasOption(Options, TEXT("SafeStart")))
+    {
+        bEnsureSafeStart = (UGameplayStatics::GetIntOption(
+                                Options, TEXT("SafeStart"), 1) != 0);
+    }
+
+    TLOG_DISPLAY(TLOG_KEY_GENERIC, "Match options!", NumberOfBots,
+                 SpawnStream.GetInitialSeed(), bEnsureSafeStart);
 }
 
 void ATGameMode::NotifyPickupAvailable(ATPickup *Pickup)
@@ -122,6 +172,8 @@ void ATGameMode::PlayerCaught(ATPlayerCharacter* PlayerCharacter)
 
     MyGameState->UpdateMatchResults(EMatchResults::Caught);
 
+    MatchProfiler.EndMatch(EMatchResults::Caught);
+
     RestartMatch();
 }
 
@@ -142,6 +194,8 @@ void ATGameMode::PlayerWon(ATPlayerCharacter* PlayerCharacter)
 
     MyGameState->UpdateMatchResults(EMatchResults::Won);
 
+    MatchProfiler.EndMatch(EMatchResults::Won);
+
     RestartMatch();
 }
 
@@ -149,6 +203,8 @@ void ATGameMode::BeginPlay()
 {
     Super::BeginPlay();
 
+    const double SpawnStartTime = FPlatformTime::Seconds();
+
     const ATSpawnArea* SpawnArea = FindSpawnArea();
     if (SpawnArea)
     {
@@ -185,13 +241,31 @@ void ATGameMode::BeginPlay()
     else
     {
         TLOG_ERROR(TLOG_KEY_GENERIC, "ERROR: cannot find an instance of spawn"
-                                     " area in the current level!")
+                                     " area in the current level!");
+    }
+
+    const double SpawnEndTime = FPlatformTime::Seconds();
+
+    FTStats::LastLayoutSpawnTime = SpawnEndTime - SpawnStartTime;
+    if (FTStats::RestartRequestTime > 0.0)
+    {
+        FTStats::LastRestartLatency = SpawnEndTime - FTStats::RestartRequestTime;
+        FTStats::RestartRequestTime = 0.0;
     }
 
     ATGameState* MyGameState = GetGameState<ATGameState>();
     checkf(MyGameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
 
     MyGameState->UpdateMatchResults(EMatchResults::OnGoing);
+
+    MatchProfiler.BeginMatch(GetWorld(), SpawnStream.GetInitialSeed());
+}
+
+void ATGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    MatchProfiler.EndMatch(EMatchResults::OnGoing);
+
+    Super::EndPlay(EndPlayReason);
 }
 
 const ATSpawnArea* ATGameMode::FindSpawnArea() const
@@ -243,6 +317,8 @@ void ATGameMode::RestartMatch()
 
 void ATGameMode::SpawnObstacles(const ATSpawnArea* SpawnArea)
 {
+    TSTAT_SCOPE(STAT_HideAndSeek_SpawnObstacles);
+
     checkf(SpawnArea, TEXT("FATAL: cannot find an instance of spawn area in the"
                            " current level!"));
     checkf(ObstacleClass.GetDefaultObject(),
@@ -252,16 +328,11 @@ void ATGameMode::SpawnObstacles(const ATSpawnArea* SpawnArea)
     SpawnInfo.SpawnCollisionHandlingOverride =
             ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
 
-    FVector Origin(SpawnArea->GetActorLocation());
-    FVector Bounds(SpawnArea->GetArea()->GetScaledBoxExtent());
-
     uint8 Count = 0;
     uint8 SpawnRetries = 0;
 
     while (Count < NumberOfObstacles) {
-        const FVector SpawnLocation(
-                    UKismetMathLibrary::RandomPointInBoundingBox(
-                        Origin, Bounds));
+        const FVector SpawnLocation(GetRandomSpawnLocation(SpawnArea));
         const FRotator SpawnRotation(0.0f, 0.0f, 0.0f);
 
         ATObstacle* Obstacle = this->GetWorld()->SpawnActor<ATObstacle>(
@@ -298,6 +369,8 @@ void ATGameMode::SpawnObstacles(const ATSpawnArea* SpawnArea)
 
 void ATGameMode::SpawnPickups(const ATSpawnArea* SpawnArea)
 {
+    TSTAT_SCOPE(STAT_HideAndSeek_SpawnPickups);
+
     checkf(SpawnArea, TEXT("FATAL: cannot find an instance of spawn area in the"
                            " current level!"));
     checkf(PickupClass.GetDefaultObject(),
@@ -307,16 +380,11 @@ void ATGameMode::SpawnPickups(const ATSpawnArea* SpawnArea)
     SpawnInfo.SpawnCollisionHandlingOverride =
             ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
 
-    FVector Origin(SpawnArea->GetActorLocation());
-    FVector Bounds(SpawnArea->GetArea()->GetScaledBoxExtent());
-
     uint8 Count = 0;
     uint8 SpawnRetries = 0;
 
     while (Count < NumberOfPickups) {
-        const FVector SpawnLocation(
-                    UKismetMathLibrary::RandomPointInBoundingBox(
-                        Origin, Bounds));
+        const FVector SpawnLocation(GetRandomSpawnLocation(SpawnArea));
         const FRotator SpawnRotation(0.0f, 0.0f, 0.0f);
 
         ATPickup* Pickup = this->GetWorld()->SpawnActor<ATPickup>(
@@ -354,6 +422,8 @@ void ATGameMode::SpawnPickups(const ATSpawnArea* SpawnArea)
 
 void ATGameMode::SpawnBots(const ATSpawnArea* SpawnArea)
 {
+    TSTAT_SCOPE(STAT_HideAndSeek_SpawnBots);
+
     checkf(SpawnArea, TEXT("FATAL: cannot find an instance of spawn area in the"
                            "current level!"));
     checkf(BotClass.GetDefaultObject(),
@@ -363,17 +433,12 @@ void ATGameMode::SpawnBots(const ATSpawnArea* SpawnArea)
     SpawnInfo.SpawnCollisionHandlingOverride =
             ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
 
-    FVector Origin(SpawnArea->GetActorLocation());
-    FVector Bounds(SpawnArea->GetArea()->GetScaledBoxExtent());
-
-    uint8 Count = 0;
+    int32 Count = 0;
     uint8 SpawnRetries = 0;
 
     while (Count < NumberOfBots) {
-        const FVector SpawnLocation(
-                    UKismetMathLibrary::RandomPointInBoundingBox(
-                        Origin, Bounds));
-        const FRotator SpawnRotation(0.0f, FMath::FRand() * 360.0f, 0.0f);
+        const FVector SpawnLocation(GetRandomSpawnLocation(SpawnArea));
+        const FRotator SpawnRotation(0.0f, SpawnStream.FRand() * 360.0f, 0.0f);
 
         ATAICharacter* Bot = this->GetWorld()->SpawnActor<ATAICharacter>(
                     BotClass.GetDefaultObject()->GetClass(),
@@ -395,15 +460,31 @@ void ATGameMode::SpawnBots(const ATSpawnArea* SpawnArea)
             ATAIController* Controller = Cast<ATAIController>(Bot->GetController());
             checkf(Controller, TEXT("FATAL: not HideAndSeekWithAI's AI"
                                     " controller!"));
-            if (!Controller->IsPlayerInSafeDistance() || Controller->IsPlayerInSight())
+            if (bEnsureSafeStart && (!Controller->IsPlayerInSafeDistance()
+                                     || Controller->IsPlayerInSight()))
             {
-                UTGameInstance* GameInstance =
-                        Cast<UTGameInstance>(UGameplayStatics::GetGameInstance(this));
-                checkf(GameInstance, TEXT("FATAL: not HideAndSeekWithAI's game"
-                                          " instance!"));
-                GameInstance->RestartCurrentLevel();
+                /* A seeded layout would come back exactly the same after a
+                 * restart; so, move on to the next location of the stream
+                 * instead. */
+                if (UGameplayStatics::HasOption(OptionsString, TEXT("Seed")))
+                {
+                    Controller->Destroy();
+                    Bot->Destroy();
+                    Bot = nullptr;
+                }
+                else
+                {
+                    UTGameInstance* GameInstance =
+                            Cast<UTGameInstance>(UGameplayStatics::GetGameInstance(this));
+                    checkf(GameInstance, TEXT("FATAL: not HideAndSeekWithAI's game"
+                                              " instance!"));
+                    GameInstance->RestartCurrentLevel();
+                }
             }
+        }
 
+        if (Bot)
+        {
             ++Count;
         }
         else
@@ -427,3 +508,13 @@ void ATGameMode::SpawnBots(const ATSpawnArea* SpawnArea)
         }
     }
 }
+
+FVector ATGameMode::GetRandomSpawnLocation(const ATSpawnArea* SpawnArea)
+{
+    const FVector Origin(SpawnArea->GetActorLocation());
+    const FVector Bounds(SpawnArea->GetArea()->GetScaledBoxExtent());
+
+    return Origin + FVector(SpawnStream.FRandRange(-Bounds.X, Bounds.X),
+                            SpawnStream.FRandRange(-Bounds.Y, Bounds.Y),
+                            SpawnStream.FRandRange(-Bounds.Z, Bounds.Z));
+}
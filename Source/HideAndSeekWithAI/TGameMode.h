@@ -3,14 +3,18 @@
 #include <CoreTypes.h>
 #include <Engine/EngineTypes.h>
 #include <GameFramework/GameMode.h>
+#include <Math/RandomStream.h>
 #include <Templates/SubclassOf.h>
 #include <UObject/ObjectMacros.h>
 
+#include "TMatchProfiler.h"
+
 #include "TGameMode.generated.h"
 
 class ATAICharacter;
 class ATPickup;
 class ATPlayerCharacter;
+class ATPlayerController;
 class ATObstacle;
 class ATSpawnArea;
 
@@ -27,7 +31,7 @@ protected:
 
     /** Number of bots to spawns. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay")
-    uint8 NumberOfBots;
+    int32 NumberOfBots;
 
     /** Obstacle class to spawn. */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay")
@@ -49,6 +53,22 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay")
     uint8 MatchRestartInterval;
 
+    /** The scripted player controller class used instead of the player
+     *  controller class when the match is played by an agent. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay")
+    TSubclassOf<ATPlayerController> PlayerAgentClass;
+
+    /** Let an agent play the game instead of a human player. It is also
+     *  possible to pass '?PlayerAgent' as a map option. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, config, Category = "Gameplay")
+    bool bUsePlayerAgent;
+
+    /** Makes sure no bot is able to see the player at the start of the match
+     *  and restarts the level otherwise. It is also possible to pass
+     *  '?SafeStart=0' as a map option. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay")
+    bool bEnsureSafeStart;
+
     /** Holds the number of ticks (passed seconds) for the match restart
      *  timer. */
     UPROPERTY(Transient)
@@ -58,6 +78,13 @@ private:
     /** The timer used to restart the match automatically when the game ends. */
     FTimerHandle MatchRestartTimer;
 
+    /** The random stream the layout gets spawned from. Passing '?Seed=' as a
+     *  map option reproduces the very same layout. */
+    FRandomStream SpawnStream;
+
+    /** Captures a CSV profile of each match when turned on. */
+    FTMatchProfiler MatchProfiler;
+
 public:
     /** If a pick item is near the player this function gets called by the
      *  pickup item in order to notify the game to show a message to the
@@ -86,8 +113,15 @@ public:
         return MatchRestartInterval - MatchRestartTimerTicks;
     }
 
+    /** Besides '?PlayerAgent', the map options '?Bots=', '?Seed=' and
+     *  '?SafeStart=' override the number of bots, the layout seed and the safe
+     *  start check. */
+    virtual void InitGame(const FString& MapName, const FString& Options,
+                          FString& ErrorMessage) override;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     /** This function only gets called during the match restart window. */
     void OnMatchRestartTimerTick();
@@ -108,4 +142,7 @@ private:
 
     /** Spawns all the bots. */
     void SpawnBots(const ATSpawnArea* SpawnArea);
+
+    /** Returns a random point inside the spawn area out of the spawn stream. */
+    FVector GetRandomSpawnLocation(const ATSpawnArea* SpawnArea);
 };
@@ -1,6 +1,12 @@
 #include "TGameState.h"
 #include "HideAndSeekWithAI.h"
 
+#include <Components/StaticMeshComponent.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+
+#include "TAICharacter.h"
+#include "TObstacle.h"
 #include "TPickup.h"
 
 ATGameState::ATGameState(const FObjectInitializer& ObjectInitializer)
@@ -8,3 +14,51 @@ ATGameState::ATGameState(const FObjectInitializer& ObjectInitializer)
 {
     AvailablePickup = nullptr;
 }
+
+void ATGameState::RegisterBot(ATAICharacter* Bot)
+{
+    if (Bot)
+    {
+        Bots.AddUnique(Bot);
+    }
+}
+
+void ATGameState::UnregisterBot(ATAICharacter* Bot)
+{
+    Bots.RemoveSingleSwap(Bot);
+}
+
+void ATGameState::RegisterObstacleBounds(const FBox& Bounds)
+{
+    if (Bounds.IsValid)
+    {
+        ObstacleBounds.Add(Bounds);
+    }
+}
+
+void ATGameState::BeginPlay()
+{
+    Super::BeginPlay();
+
+    /* The obstacles register themselves; the static level geometry blocking
+     * the pickup items gets collected once here. */
+    for (TActorIterator<AActor> ActorItr(GetWorld()); ActorItr; ++ActorItr)
+    {
+        if (ActorItr->IsA<ATObstacle>() || ActorItr->IsA<ATPickup>())
+        {
+            continue;
+        }
+
+        TInlineComponentArray<UStaticMeshComponent*> Meshes(*ActorItr);
+        for (const UStaticMeshComponent* Mesh : Meshes)
+        {
+            if (Mesh->Mobility == EComponentMobility::Static
+                    && Mesh->IsCollisionEnabled()
+                    && Mesh->GetCollisionResponseToChannel(ECC_PhysicsBody)
+                    == ECR_Block)
+            {
+                RegisterObstacleBounds(Mesh->Bounds.GetBox());
+            }
+        }
+    }
+}
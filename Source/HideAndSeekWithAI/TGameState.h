@@ -1,13 +1,16 @@
 #pragma once
 
+#include <Containers/Array.h>
 #include <CoreTypes.h>
 #include <GameFramework/GameState.h>
+#include <Math/Box.h>
 #include <UObject/ObjectMacros.h>
 
 #include "HideAndSeekWithAI.h"
 
 #include "TGameState.generated.h"
 
+class ATAICharacter;
 class ATPickup;
 
 /** The game's game state used to store the game data. */
@@ -27,6 +30,16 @@ protected:
     UPROPERTY(Transient)
     ATPickup* AvailablePickup;
 
+    /** All the bots that are currently playing in the match. */
+    UPROPERTY(Transient)
+    TArray<ATAICharacter*> Bots;
+
+    /** The bounding boxes of all the obstacles and of the static level
+     *  geometry, e.g. the walls; none of them ever moves, so these stay valid
+     *  for the whole match. */
+    UPROPERTY(Transient)
+    TArray<FBox> ObstacleBounds;
+
 public:
     /** Returns the match result. */
     FORCEINLINE const EMatchResults& GetMatchResults() const
@@ -77,4 +90,29 @@ public:
     {
         AvailablePickup = Pickup;
     }
+
+    /** Returns all the bots that are currently playing in the match. */
+    FORCEINLINE const TArray<ATAICharacter*>& GetBots() const
+    {
+        return Bots;
+    }
+
+    /** Adds a bot to the list of bots playing in the match. */
+    void RegisterBot(ATAICharacter* Bot);
+
+    /** Removes a bot from the list of bots playing in the match. */
+    void UnregisterBot(ATAICharacter* Bot);
+
+    /** Returns the bounding boxes of all the obstacles and of the static
+     *  level geometry. */
+    FORCEINLINE const TArray<FBox>& GetObstacleBounds() const
+    {
+        return ObstacleBounds;
+    }
+
+    /** Adds the bounding box of an obstacle. */
+    void RegisterObstacleBounds(const FBox& Bounds);
+
+protected:
+    virtual void BeginPlay() override;
 };
@@ -16,6 +16,7 @@
 #include <Widgets/SCanvas.h>
 
 #include "THUD.h"
+#include "TStyle.h"
 
 #define LOCTEXT_NAMESPACE "STGameWidget"
 
@@ -37,7 +38,8 @@ void STGameWidget::Construct(
                 .Padding(FMargin(100.0f))
                 [
                     SNew(STextBlock)
-                    .TextStyle(GetTextStyle())
+                    .TextStyle(&FTStyle::Get().GetWidgetStyle<FTextBlockStyle>(
+                                   FTStyle::GAME_MESSAGE))
                     .Text(TAttribute<FText>::Create(
                               TAttribute<FText>::FGetter::CreateUObject(
                                   OwnerHUD.Get(),
@@ -51,7 +53,8 @@ void STGameWidget::Construct(
                 .Padding(FMargin(200.0f))
                 [
                     SNew(STextBlock)
-                    .TextStyle(GetTextStyle())
+                    .TextStyle(&FTStyle::Get().GetWidgetStyle<FTextBlockStyle>(
+                                   FTStyle::GAME_MESSAGE))
                     .Text(TAttribute<FText>::Create(
                               TAttribute<FText>::FGetter::CreateUObject(
                                   OwnerHUD.Get(),
@@ -64,14 +67,4 @@ void STGameWidget::Construct(
 
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
-const FTextBlockStyle* STGameWidget::GetTextStyle() const
-{
-    FTextBlockStyle* Style = new FTextBlockStyle();
-
-    Style->SetFont(TTF_FONT("LiberationSans-Bold", 40));
-    Style->SetColorAndOpacity(FLinearColor::Yellow);
-
-    return Style;
-}
-
 #undef LOCTEXT_NAMESPACE
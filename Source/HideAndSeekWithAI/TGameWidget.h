@@ -1,7 +1,6 @@
 #pragma once
 
 #include <Slate/SlateGameResources.h>
-#include <Styling/SlateTypes.h>
 #include <UObject/WeakObjectPtrTemplates.h>
 #include <Widgets/SCompoundWidget.h>
 
@@ -25,8 +24,4 @@ public:
 protected:
     /** The game HUD that owns this widget. */
     TWeakObjectPtr<ATHUD> OwnerHUD;
-
-protected:
-    /** Provides the style for all the text shown in this widget. */
-    const FTextBlockStyle* GetTextStyle() const;
 };
@@ -4,22 +4,69 @@
 #include <Kismet/GameplayStatics.h>
 #include <Widgets/SWeakWidget.h>
 
+#include "TAIStateOverlay.h"
 #include "TGameMode.h"
 #include "TGameState.h"
 #include "TGameWidget.h"
 #include "TPlayerCharacter.h"
 #include "TPlayerController.h"
 
+/** The shadow color shared by all the AI state markers. */
+static const FLinearColor MARKER_SHADOW_COLOR(0.0f, 0.0f, 0.0f, 0.2f);
+
+FTAIStateMarkerStyle::FTAIStateMarkerStyle()
+    : Color(FLinearColor::White),
+      ShadowColor(MARKER_SHADOW_COLOR)
+{
+
+}
+
+FTAIStateMarkerStyle::FTAIStateMarkerStyle(const TCHAR* InText,
+                                           const FLinearColor& InColor)
+    : Text(FText::FromString(InText)),
+      Color(InColor),
+      ShadowColor(MARKER_SHADOW_COLOR)
+{
+
+}
+
 ATHUD::ATHUD(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
-
+    PrimaryActorTick.bCanEverTick = true;
+    IdleMarker = FTAIStateMarkerStyle(TEXT("."), FLinearColor::Green);
+    SuspiciousMarker = FTAIStateMarkerStyle(TEXT("?"), FLinearColor::Yellow);
+    AlertedMarker = FTAIStateMarkerStyle(TEXT("!"), FLinearColor::Red);
+    InvestigatingMarker = FTAIStateMarkerStyle(
+                TEXT("#"), FLinearColor::FromSRGBColor(FColor::Orange));
+    CarryingItemMarker = FTAIStateMarkerStyle(TEXT("*"), FLinearColor::Blue);
+    GoingBackMarker = FTAIStateMarkerStyle(
+                TEXT(">>"), FLinearColor::FromSRGBColor(FColor::Cyan));
 }
 
 void ATHUD::BeginPlay()
 {
     Super::BeginPlay();
 
+    GameState = Cast<ATGameState>(UGameplayStatics::GetGameState(GetWorld()));
+    checkf(GameState.IsValid(),
+           TEXT("FATAL: not HideAndSeekWithAI's game state!"));
+
+    /* Only exists where the match is run; the restart countdown reads 0
+     * elsewhere. */
+    GameMode = Cast<ATGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+
+    /* Shows the title right away instead of after the first tick. */
+    ViewModel.Update(FTHUDViewModel::FInputs());
+
+    /* Goes first, so the game messages are drawn on top of the markers. */
+    AIStateOverlay = SNew(STAIStateOverlay).OwnerHUD(this);
+
+    GEngine->GameViewport->AddViewportWidgetContent(
+        SNew(SWeakWidget)
+        .PossiblyNullContent(AIStateOverlay.ToSharedRef())
+    );
+
     GameWidget = SNew(STGameWidget).OwnerHUD(this);
 
     GEngine->GameViewport->AddViewportWidgetContent(
@@ -30,87 +77,78 @@ void ATHUD::BeginPlay()
     GameWidget->SetVisibility(EVisibility::Visible);
 }
 
-FText ATHUD::GetMatchResultsText() const
+const FTAIStateMarkerStyle& ATHUD::GetAIStateMarkerStyle(
+        const EAIState& State) const
 {
-    ATGameState *GameState = Cast<ATGameState>(
-                UGameplayStatics::GetGameState(GetWorld()));
-    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
-
-    switch (GameState->GetMatchResults())
+    switch (State)
     {
-    case EMatchResults::OnGoing:
-        return FText::FromString(FString("Don't Get Caught Challenge!"));
-    case EMatchResults::Caught:
-        return FText::FromString(FString("You lost!"));
-    case EMatchResults::Won:
-        return FText::FromString(FString("You won!"));
+    case EAIState::Idle:
+        return IdleMarker;
+    case EAIState::Suspicious:
+        return SuspiciousMarker;
+    case EAIState::Alerted:
+        return AlertedMarker;
+    case EAIState::Investigating:
+        return InvestigatingMarker;
+    case EAIState::CarryingItem:
+        return CarryingItemMarker;
+    case EAIState::GoingBack:
+        return GoingBackMarker;
     }
 
-    return FText::FromString(FString(""));
+    return IdleMarker;
 }
 
-FText ATHUD::GetGameMessageText() const
+void ATHUD::Tick(float DeltaSeconds)
 {
-    ATGameState *GameState = Cast<ATGameState>(
-                UGameplayStatics::GetGameState(GetWorld()));
-    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
-
-    ATGameMode *GameMode = Cast<ATGameMode>(
-                UGameplayStatics::GetGameMode(GetWorld()));
-    checkf(GameMode, TEXT("FATAL: not HideAndSeekWithAI's game mode!"));
+    Super::Tick(DeltaSeconds);
 
-    if (GameState->GetMatchResults() != EMatchResults::OnGoing)
+    const ATGameState* CurrentGameState = GameState.Get();
+    if (!CurrentGameState)
     {
-        FString Message(FString::Printf(
-                            TEXT("The match will restart in %d seconds..."),
-                            GameMode->GetMatchRestartRemainingTime()));
-        return FText::FromString(Message);
+        return;
     }
 
-    if (!PlayerOwner)
-    {
-        return FText::FromString("");
-    }
+    FTHUDViewModel::FInputs Inputs;
+    Inputs.MatchResults = CurrentGameState->GetMatchResults();
 
-    ATPlayerController *PlayerController = Cast<ATPlayerController>(
-                PlayerOwner);
-    if (!PlayerController)
+    if (Inputs.MatchResults != EMatchResults::OnGoing)
     {
-        return FText::FromString("");
+        const ATGameMode* CurrentGameMode = GameMode.Get();
+        Inputs.RestartRemainingTime =
+                CurrentGameMode ? CurrentGameMode->GetMatchRestartRemainingTime()
+                                : 0;
+        ViewModel.Update(Inputs);
+        return;
     }
 
-    ATPlayerCharacter *PlayerCharacter = Cast<ATPlayerCharacter>(
-                PlayerController->GetCharacter());
-    if (!PlayerCharacter)
-    {
-        return FText::FromString("");
-    }
+    const ATPlayerController* PlayerController =
+            Cast<ATPlayerController>(PlayerOwner);
+    const ATPlayerCharacter* PlayerCharacter = PlayerController
+            ? Cast<ATPlayerCharacter>(PlayerController->GetCharacter())
+            : nullptr;
 
-    if (PlayerCharacter->HasAnyItems())
+    if (PlayerCharacter && PlayerCharacter->HasAnyItems())
     {
         if (PlayerController->IsThrowingItem())
         {
-            return FText::FromString(
-                        FString::Printf(
-                            TEXT("Thworing Time: %.2f; Power: %.0f%%; Distance: %.1fcm;"),
-                            PlayerController->GetThrowingAccumulatedTime(),
-                            PlayerController->GetThrowingPower(),
-                            PlayerController->GetEstimatedThrowingDistance()));
+            Inputs.GameMessage = FTHUDViewModel::EGameMessage::ThrowingItem;
+            Inputs.ThrowingTime = PlayerController->GetThrowingAccumulatedTime();
+            Inputs.ThrowingPower = PlayerController->GetThrowingPower();
+            Inputs.ThrowingDistance =
+                    PlayerController->GetEstimatedThrowingDistance();
+            Inputs.ThrowPowerBucket =
+                    FTHUDViewModel::ToThrowPowerBucket(Inputs.ThrowingPower);
         }
         else
         {
-            return FText::FromString(
-                        FString("In order to distract the guards,"
-                                " throw your picked up item!"));
+            Inputs.GameMessage = FTHUDViewModel::EGameMessage::HoldingItem;
         }
     }
-    else if (GameState->IsPickupAvailable())
+    else if (PlayerCharacter && CurrentGameState->IsPickupAvailable())
     {
-        return FText::FromString(
-                    FString("Pickup Available! Press LMB to pick it up!"));
-    }
-    else
-    {
-        return FText::FromString(FString(""));
+        Inputs.GameMessage = FTHUDViewModel::EGameMessage::PickupAvailable;
     }
+
+    ViewModel.Update(Inputs);
 }
@@ -1,12 +1,44 @@
 #pragma once
 
 #include <GameFramework/HUD.h>
+#include <Internationalization/Text.h>
+#include <Math/Color.h>
 #include <UObject/ObjectMacros.h>
+#include <UObject/WeakObjectPtrTemplates.h>
+
+#include "HideAndSeekWithAI.h"
+#include "THUDViewModel.h"
 
 #include "THUD.generated.h"
 
+class STAIStateOverlay;
 class STGameWidget;
 
+class ATGameMode;
+class ATGameState;
+
+/** The look of the marker shown above the bots in a single AI state. */
+USTRUCT(BlueprintType)
+struct HIDEANDSEEKWITHAI_API FTAIStateMarkerStyle
+{
+    GENERATED_BODY()
+
+    /** The displayed text. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FText Text;
+
+    /** The displayed text color. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FLinearColor Color;
+
+    /** The displayed text shadow color. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FLinearColor ShadowColor;
+
+    FTAIStateMarkerStyle();
+    FTAIStateMarkerStyle(const TCHAR* InText, const FLinearColor& InColor);
+};
+
 /** The main game head-up display */
 UCLASS(Abstract, Blueprintable, BlueprintType, config=Game)
 class HIDEANDSEEKWITHAI_API ATHUD : public AHUD
@@ -14,20 +46,73 @@ class HIDEANDSEEKWITHAI_API ATHUD : public AHUD
     GENERATED_UCLASS_BODY()
 
 protected:
+    /** Displayed marker on bots' heads when they are in idle state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle IdleMarker;
+
+    /** Displayed marker on bots' heads when they are in suspicious state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle SuspiciousMarker;
+
+    /** Displayed marker on bots' heads when they are in alerted state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle AlertedMarker;
+
+    /** Displayed marker on bots' heads when they are in investigating
+     *  state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle InvestigatingMarker;
+
+    /** Displayed marker on bots' heads when they are in carrying item
+     *  state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle CarryingItemMarker;
+
+    /** Displayed marker on bots' heads when they are in going back state. */
+    UPROPERTY(EditDefaultsOnly, Category = "AI")
+    FTAIStateMarkerStyle GoingBackMarker;
+
     /** Refrence to main game's widget for displaying game results and
      *  messages. */
     TSharedPtr<STGameWidget> GameWidget;
 
+    /** Reference to the overlay drawing the AI state markers of all the
+     *  bots. */
+    TSharedPtr<STAIStateOverlay> AIStateOverlay;
+
+private:
+    /** The cached texts shown by the main game's widget. */
+    FTHUDViewModel ViewModel;
+
+    /** The game state and game mode the view model inputs come from; looked
+     *  up once the HUD begins play. */
+    TWeakObjectPtr<ATGameState> GameState;
+    TWeakObjectPtr<ATGameMode> GameMode;
+
 public:
+    /** Returns the marker style of an AI state. */
+    const FTAIStateMarkerStyle& GetAIStateMarkerStyle(
+            const EAIState& State) const;
+
     /** Returns the game results or title message to be displayed inside the
      *  game's main widget.*/
-    FText GetMatchResultsText() const;
+    FORCEINLINE FText GetMatchResultsText() const
+    {
+        return ViewModel.GetMatchResultsText();
+    }
 
     /** Returns the game messages (e.g. available pickup items notification,
      *  timed item throwing feed back, etc) to be displayed inside the game's
         .main widget. */
-    FText GetGameMessageText() const;
+    FORCEINLINE FText GetGameMessageText() const
+    {
+        return ViewModel.GetGameMessageText();
+    }
 
 protected:
     virtual void BeginPlay() override;
+
+public:
+    /** Pushes the current match and player situation into the view model. */
+    virtual void Tick(float DeltaSeconds) override;
 };
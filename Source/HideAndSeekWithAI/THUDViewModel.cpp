@@ -0,0 +1,95 @@
+#include "THUDViewModel.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Containers/UnrealString.h>
+
+FTHUDViewModel::FInputs::FInputs()
+    : MatchResults(EMatchResults::OnGoing),
+      RestartRemainingTime(0),
+      GameMessage(EGameMessage::None),
+      ThrowPowerBucket(0),
+      ThrowingTime(0.0f),
+      ThrowingPower(0.0f),
+      ThrowingDistance(0.0f)
+{
+
+}
+
+bool FTHUDViewModel::FInputs::operator==(const FInputs& Other) const
+{
+    /* The exact throw values only matter through their bucket. */
+    return MatchResults == Other.MatchResults
+            && RestartRemainingTime == Other.RestartRemainingTime
+            && GameMessage == Other.GameMessage
+            && ThrowPowerBucket == Other.ThrowPowerBucket;
+}
+
+FTHUDViewModel::FTHUDViewModel()
+    : bInitialized(false),
+      OnGoingText(FText::FromString(FString("Don't Get Caught Challenge!"))),
+      CaughtText(FText::FromString(FString("You lost!"))),
+      WonText(FText::FromString(FString("You won!"))),
+      PickupAvailableText(FText::FromString(
+                              FString("Pickup Available! Press LMB to pick it"
+                                      " up!"))),
+      HoldingItemText(FText::FromString(
+                          FString("In order to distract the guards, throw your"
+                                  " picked up item!")))
+{
+
+}
+
+void FTHUDViewModel::Update(const FInputs& NewInputs)
+{
+    if (bInitialized && NewInputs == Inputs)
+    {
+        return;
+    }
+
+    switch (NewInputs.MatchResults)
+    {
+    case EMatchResults::OnGoing:
+        MatchResultsText = OnGoingText;
+        break;
+    case EMatchResults::Caught:
+        MatchResultsText = CaughtText;
+        break;
+    case EMatchResults::Won:
+        MatchResultsText = WonText;
+        break;
+    }
+
+    if (NewInputs.MatchResults != EMatchResults::OnGoing)
+    {
+        GameMessageText = FText::FromString(
+                    FString::Printf(
+                        TEXT("The match will restart in %d seconds..."),
+                        NewInputs.RestartRemainingTime));
+    }
+    else
+    {
+        switch (NewInputs.GameMessage)
+        {
+        case EGameMessage::None:
+            GameMessageText = FText::GetEmpty();
+            break;
+        case EGameMessage::PickupAvailable:
+            GameMessageText = PickupAvailableText;
+            break;
+        case EGameMessage::HoldingItem:
+            GameMessageText = HoldingItemText;
+            break;
+        case EGameMessage::ThrowingItem:
+            GameMessageText = FText::FromString(
+                        FString::Printf(
+                            TEXT("Thworing Time: %.2f; Power: %.0f%%; Distance: %.1fcm;"),
+                            NewInputs.ThrowingTime,
+                            NewInputs.ThrowingPower,
+                            NewInputs.ThrowingDistance));
+            break;
+        }
+    }
+
+    Inputs = NewInputs;
+    bInitialized = true;
+}
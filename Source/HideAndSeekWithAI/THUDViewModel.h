@@ -0,0 +1,95 @@
+#pragma once
+
+#include <CoreTypes.h>
+#include <Internationalization/Text.h>
+#include <Math/UnrealMathUtility.h>
+
+#include "HideAndSeekWithAI.h"
+
+/** The texts shown by the game's main widget, cached. The HUD gathers the few
+ *  inputs they depend on every frame and pushes them in; the texts only get
+ *  formatted again once one of the inputs changes, so painting the widget is
+ *  just a matter of reading them. */
+class HIDEANDSEEKWITHAI_API FTHUDViewModel
+{
+public:
+    /** The game message shown below the match results. */
+    enum class EGameMessage : uint8
+    {
+        None,
+        PickupAvailable,
+        HoldingItem,
+        ThrowingItem
+    };
+
+    /** Everything the texts depend on. */
+    struct FInputs
+    {
+        EMatchResults MatchResults;
+
+        /** The seconds left until the match restarts once it is over. */
+        uint8 RestartRemainingTime;
+
+        EGameMessage GameMessage;
+
+        /** The throw power rounded down to THROW_POWER_BUCKET, while throwing
+         *  an item. */
+        int32 ThrowPowerBucket;
+
+        /** The exact throw values shown once the bucket changes. */
+        float ThrowingTime;
+        float ThrowingPower;
+        float ThrowingDistance;
+
+        FInputs();
+
+        /** Whether the shown texts would be the same or not. */
+        bool operator==(const FInputs& Other) const;
+    };
+
+public:
+    /** The granularity of the throw power shown while throwing an item, in
+     *  percents. */
+    static constexpr int32 THROW_POWER_BUCKET = 5;
+
+private:
+    /** The inputs the texts were formatted for last. */
+    FInputs Inputs;
+
+    /** Whether the texts have been formatted at least once or not. */
+    bool bInitialized;
+
+    /** The texts that never change, created once. */
+    const FText OnGoingText;
+    const FText CaughtText;
+    const FText WonText;
+    const FText PickupAvailableText;
+    const FText HoldingItemText;
+
+    FText MatchResultsText;
+    FText GameMessageText;
+
+public:
+    FTHUDViewModel();
+
+    /** Formats the texts again if any of the inputs has changed. */
+    void Update(const FInputs& NewInputs);
+
+    /** Returns the game results or title message. */
+    FORCEINLINE const FText& GetMatchResultsText() const
+    {
+        return MatchResultsText;
+    }
+
+    /** Returns the game message. */
+    FORCEINLINE const FText& GetGameMessageText() const
+    {
+        return GameMessageText;
+    }
+
+    /** Returns the throw power bucket a throw power falls into. */
+    static FORCEINLINE int32 ToThrowPowerBucket(const float ThrowingPower)
+    {
+        return FMath::FloorToInt(ThrowingPower / THROW_POWER_BUCKET);
+    }
+};
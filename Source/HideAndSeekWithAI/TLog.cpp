@@ -1,9 +1,13 @@
 #include "TLog.h"
 
-#include <Containers/Map.h>
 #include <Engine/Engine.h>
+#include <HAL/PlatformTime.h>
+#include <HAL/ThreadingBase.h>
 #include <Logging/LogMacros.h>
 
+#include "TLogWriter.h"
+#include "TStats.h"
+
 DEFINE_LOG_CATEGORY ( Log_AI )
 DEFINE_LOG_CATEGORY ( Log_Generic )
 DEFINE_LOG_CATEGORY ( Log_Input )
@@ -11,110 +15,97 @@ DEFINE_LOG_CATEGORY ( Log_Player )
 
 static constexpr float ON_SCREEN_LOG_DURATION = 8.0f;
 
-struct TLogCore::StaticImpl
-{
-public:
-    struct VerbosityMapper
-    {
-        FString Tag;
-        FColor Color;
-
-        VerbosityMapper(const FString& tag,
-                        const FColor& color);
-    };
-
-public:
-    TMap<TLogCore::EVerbosity, VerbosityMapper> VerbosityMap;
-
-    bool bInitialized;
+/** The verbosity tags and colors, in the order of TLogCore::EVerbosity. Both
+ *  tables are constant, so any thread may read them at any time without
+ *  waiting for anything to get initialized. */
+static const TCHAR* const VERBOSITY_TAGS[] = {
+    TEXT("FATAL"),
+    TEXT("ERROR"),
+    TEXT("WARNING"),
+    TEXT("DISPLAY"),
+    TEXT("LOG"),
+    TEXT("VERBOSE"),
+    TEXT("VERY_VERBOSE")
+};
 
-public:
-    StaticImpl();
+static const FColor VERBOSITY_COLORS[] = {
+    FColor(255, 255, 255),  /* White */
+    FColor(255, 0, 0),      /* Red */
+    FColor(255, 255, 0),    /* Yellow */
+    FColor(0, 255, 0),      /* Green */
+    FColor(189, 195, 199),  /* Silver */
+    FColor(169, 7, 228),    /* Purple */
+    FColor(255, 0, 255)     /* Magenta */
 };
 
-struct TLogCore::Impl
+static_assert(UE_ARRAY_COUNT(VERBOSITY_TAGS)
+              == static_cast<std::size_t>(TLogCore::EVerbosity::VeryVerbose) + 1,
+              "Error: every verbosity needs a tag!");
+static_assert(UE_ARRAY_COUNT(VERBOSITY_COLORS)
+              == UE_ARRAY_COUNT(VERBOSITY_TAGS),
+              "Error: every verbosity needs a color!");
+
+TLogCore::TLogCore(const TLogSite& CallSite)
+    : Site(&CallSite),
+      bAnyEntries(false),
+      bBinary(false),
+      Cycles(0)
 {
-public:
-    TLogCore::EVerbosity Verbosity;
-    TLogCore::ECategory Category;
-    uint64 Key;
-    FString File;
-    FString Function;
-    FString Line;
-};
+#if defined ( HIDEANDSEEKWITHAI_LOGGING )
+    Cycles = FPlatformTime::Cycles64();
+
+    /* Errors must always be readable right away; so, they stay text. */
+    if (CallSite.Verbosity != EVerbosity::Fatal
+            && CallSite.Verbosity != EVerbosity::Error
+            && FTLogBinary::IsEnabled() && FTLogWriter::IsRunning())
+    {
+        bBinary = true;
+    }
+#endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
+}
 
-TLogCore::StaticImplDeleter TLogCore::SPimplDeleter;
-std::unique_ptr<TLogCore::StaticImpl, TLogCore::StaticImplDeleter> TLogCore::SPimpl =
-        std::unique_ptr<TLogCore::StaticImpl, TLogCore::StaticImplDeleter>(
-        new TLogCore::StaticImpl{}, TLogCore::SPimplDeleter);
-
-TLogCore::TLogCore(const EVerbosity& Verbosity,
-                   const ECategory& Category,
-                   const uint64 Key,
-                   const std::string& File,
-                   const std::string& Function,
-                   const int32 Line)
-    : Pimpl(std::unique_ptr<Impl, ImplDeleter>(new Impl{}, PimplDeleter)),
-      bAnyEntries(false)
+TLogCore::~TLogCore()
 {
+    TSTAT_SCOPE(STAT_HideAndSeek_TLogEmit);
+
 #if defined ( HIDEANDSEEKWITHAI_LOGGING )
-    if (!SPimpl->bInitialized)
+    if (bBinary)
     {
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Fatal,
-                    StaticImpl::VerbosityMapper(TEXT("FATAL"), FColor::White));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Error,
-                    StaticImpl::VerbosityMapper(TEXT("ERROR"), FColor::Red));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Warning,
-                    StaticImpl::VerbosityMapper(TEXT("WARNING"),
-                                                FColor::Yellow));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Display,
-                    StaticImpl::VerbosityMapper(TEXT("DISPLAY"),
-                                                FColor::Green));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Log,
-                    StaticImpl::VerbosityMapper(TEXT("LOG"), FColor::Silver));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::Verbose,
-                    StaticImpl::VerbosityMapper(TEXT("VERBOSE"),
-                                                FColor::Purple));
-        SPimpl->VerbosityMap.Add(
-                    TLogCore::EVerbosity::VeryVerbose,
-                    StaticImpl::VerbosityMapper(TEXT("VERY_VERBOSE"),
-                                                FColor::Magenta));
-
-        SPimpl->bInitialized = true;
+        FTLogWriter::PushBinary(*Site, Cycles, Payload);
+        return;
     }
 
-    Pimpl->Verbosity = Verbosity;
-    Pimpl->Category = Category;
-    Pimpl->Key = Key;
-    Pimpl->File = FString(StringCast<WIDECHAR>(File.c_str()).Get());
-    Pimpl->Function = FString(StringCast<WIDECHAR>(Function.c_str()).Get());
-    Pimpl->Line = FString::FromInt(Line);
+    /* Fatal entries crash right away; so, they never wait in the ring. */
+    if (Site->Verbosity != EVerbosity::Fatal
+            && FTLogWriter::Push(*Site, Cycles, Buffer.ToString(),
+                                  Buffer.Len()))
+    {
+        return;
+    }
+
+    WriteToLog(*Site, Buffer.ToString());
+    WriteOnScreen(*Site, Buffer.ToString());
 #endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
 }
 
-TLogCore::~TLogCore()
+void TLogCore::WriteToLog(const TLogSite& CallSite, const TCHAR* Entry)
 {
 #if defined ( HIDEANDSEEKWITHAI_LOGGING )
-    const EVerbosity& Verbosity = Pimpl->Verbosity;
-    const ECategory& Category = Pimpl->Category;
-    const StaticImpl::VerbosityMapper& VerbosityMapper =
-            SPimpl->VerbosityMap[Verbosity];
-    const FString &Tag = VerbosityMapper.Tag;
-    const FColor &Color = VerbosityMapper.Color;
-
-    const FString Message(FString::Printf(
-                              TEXT("[%s %s %s %s] %s"),
-                              Tag.GetCharArray().GetData(),
-                              Pimpl->File.GetCharArray().GetData(),
-                              Pimpl->Function.GetCharArray().GetData(),
-                              Pimpl->Line.GetCharArray().GetData(),
-                              Buffer.GetCharArray().GetData()));
+    const EVerbosity& Verbosity = CallSite.Verbosity;
+    const ECategory& Category = CallSite.Category;
+
+    /* [Tag File Function Line] Entry */
+    TStringBuilder<TLOG_INLINE_BUFFER_SIZE * 2> Message;
+    Message.AppendChar(TEXT('['));
+    Message.Append(GetTag(Verbosity));
+    Message.AppendChar(TEXT(' '));
+    TLogFormat::AppendChars(Message, CallSite.File);
+    Message.AppendChar(TEXT(' '));
+    TLogFormat::AppendChars(Message, CallSite.Function);
+    Message.AppendChar(TEXT(' '));
+    TLogFormat::AppendInteger(Message, CallSite.Line);
+    Message.Append(TEXT("] "));
+    Message.Append(Entry);
 
     /// Generic
     if (Category == ECategory::Generic)
@@ -125,49 +116,49 @@ TLogCore::~TLogCore()
         case EVerbosity::Display:
         {
             UE_LOG(Log_Generic, Display, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Error:
         {
             UE_LOG(Log_Generic, Error, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Fatal:
         {
             UE_LOG(Log_Generic, Fatal, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Log:
         {
             UE_LOG(Log_Generic, Log, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Verbose:
         {
             UE_LOG(Log_Generic, Verbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::VeryVerbose:
         {
             UE_LOG(Log_Generic, VeryVerbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Warning:
         {
             UE_LOG(Log_Generic, Warning, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
@@ -182,49 +173,49 @@ TLogCore::~TLogCore()
         case EVerbosity::Display:
         {
             UE_LOG(Log_AI, Display, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Error:
         {
             UE_LOG(Log_AI, Error, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Fatal:
         {
             UE_LOG(Log_AI, Fatal, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Log:
         {
             UE_LOG(Log_AI, Log, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Verbose:
         {
             UE_LOG(Log_AI, Verbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::VeryVerbose:
         {
             UE_LOG(Log_AI, VeryVerbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Warning:
         {
             UE_LOG(Log_AI, Warning, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
@@ -240,49 +231,49 @@ TLogCore::~TLogCore()
         case EVerbosity::Display:
         {
             UE_LOG(Log_Input, Display, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Error:
         {
             UE_LOG(Log_Input, Error, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Fatal:
         {
             UE_LOG(Log_Input, Fatal, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Log:
         {
             UE_LOG(Log_Input, Log, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Verbose:
         {
             UE_LOG(Log_Input, Verbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::VeryVerbose:
         {
             UE_LOG(Log_Input, VeryVerbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Warning:
         {
             UE_LOG(Log_Input, Warning, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
@@ -297,92 +288,93 @@ TLogCore::~TLogCore()
         case EVerbosity::Display:
         {
             UE_LOG(Log_Player, Display, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Error:
         {
             UE_LOG(Log_Player, Error, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Fatal:
         {
             UE_LOG(Log_Player, Fatal, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Log:
         {
             UE_LOG(Log_Player, Log, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Verbose:
         {
             UE_LOG(Log_Player, Verbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::VeryVerbose:
         {
             UE_LOG(Log_Player, VeryVerbose, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         case EVerbosity::Warning:
         {
             UE_LOG(Log_Player, Warning, TEXT("%s"),
-                   Message.GetCharArray().GetData());
+                   Message.ToString());
         }
             break;
 
         }
     }
 
-    if (GEngine)
-    {
-        const FString OnScreenMessage(
-                    FString::Printf(TEXT("[%s %s %s] %s"),
-                                    Tag.GetCharArray().GetData(),
-                                    Pimpl->Function.GetCharArray().GetData(),
-                                    Pimpl->Line.GetCharArray().GetData(),
-                                    Buffer.GetCharArray().GetData()));
-
-        GEngine->AddOnScreenDebugMessage(Pimpl->Key, ON_SCREEN_LOG_DURATION,
-                                         Color, OnScreenMessage);
-    }
-
+#else
+    (void)CallSite;
+    (void)Entry;
 #endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
 }
 
-TLogCore::StaticImpl::StaticImpl()
-    : bInitialized(false)
-{
-
-}
-
-TLogCore::StaticImpl::VerbosityMapper::VerbosityMapper(
-        const FString& tag,
-        const FColor& color)
-    : Tag(tag),
-      Color(color)
+void TLogCore::WriteOnScreen(const TLogSite& CallSite, const TCHAR* Entry)
 {
+#if defined ( HIDEANDSEEKWITHAI_LOGGING )
+    /* The on-screen messages are not thread-safe; the log writer hands them
+     * back to the game thread at the end of the frame. */
+    if (!GEngine || !IsInGameThread())
+    {
+        return;
+    }
 
+    const FString OnScreenMessage(
+                FString::Printf(TEXT("[%s %s %d] %s"),
+                                GetTag(CallSite.Verbosity),
+                                ANSI_TO_TCHAR(CallSite.Function),
+                                CallSite.Line,
+                                Entry));
+
+    GEngine->AddOnScreenDebugMessage(CallSite.Key, ON_SCREEN_LOG_DURATION,
+                                     GetColor(CallSite.Verbosity),
+                                     OnScreenMessage);
+#else
+    (void)CallSite;
+    (void)Entry;
+#endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
 }
 
-void TLogCore::StaticImplDeleter::operator()(TLogCore::StaticImpl* Pointer)
+const TCHAR* TLogCore::GetTag(const EVerbosity& Verbosity)
 {
-    delete Pointer;
+    return VERBOSITY_TAGS[static_cast<uint8>(Verbosity)];
 }
 
-void TLogCore::ImplDeleter::operator()(TLogCore::Impl* Pointer)
+const FColor& TLogCore::GetColor(const EVerbosity& Verbosity)
 {
-    delete Pointer;
+    return VERBOSITY_COLORS[static_cast<uint8>(Verbosity)];
 }
@@ -1,18 +1,27 @@
 #pragma once
 
-#include <memory>
 #include <string>
+#include <type_traits>
 
 #include <cstddef>
 #include <cstdio>
+#include <cstring>
 
 #include <Containers/StringConv.h>
 #include <Containers/UnrealString.h>
 #include <CoreTypes.h>
 #include <GameFramework/Actor.h>
+#include <Logging/LogMacros.h>
 #include <Logging/LogVerbosity.h>
+#include <Math/Color.h>
 #include <Math/Rotator.h>
+#include <Math/UnrealMathUtility.h>
 #include <Math/Vector.h>
+#include <Misc/StringBuilder.h>
+
+#include "TLogBinary.h"
+#include "TLogFilter.h"
+#include "TLogFloat.h"
 
 DECLARE_LOG_CATEGORY_EXTERN ( Log_AI, All, All );
 DECLARE_LOG_CATEGORY_EXTERN ( Log_Generic, All, All );
@@ -25,6 +34,159 @@ static constexpr uint64 TLOG_KEY_GENERIC = static_cast<uint64>(100);
 static constexpr uint64 TLOG_KEY_INPUT = static_cast<uint64>(200);
 static constexpr uint64 TLOG_KEY_PLAYER = static_cast<uint64>(300);
 
+/** The size of the inline buffer a log entry gets assembled in; longer
+ *  entries spill to the heap. */
+static constexpr int32 TLOG_INLINE_BUFFER_SIZE = 512;
+
+/** Helpers the formatters append through. None of them allocates unless the
+ *  entry outgrows its inline buffer. */
+struct TLogFormat
+{
+    /** Appends a null-terminated string of any character type; the characters
+     *  get widened one by one. */
+    template<typename CHAR>
+    static FORCEINLINE void AppendChars(FStringBuilderBase& Out_String,
+                                        const CHAR* Value)
+    {
+        for (; *Value; ++Value)
+        {
+            Out_String.AppendChar(static_cast<TCHAR>(*Value));
+        }
+    }
+
+    /** Appends a printf formatted value through a stack buffer. */
+    template<typename... ARGUMENTS>
+    static FORCEINLINE void AppendPrintf(FStringBuilderBase& Out_String,
+                                         const char* Format,
+                                         ARGUMENTS... Arguments)
+    {
+        char Buffer[128];
+        const int Length = std::snprintf(Buffer, sizeof(Buffer), Format,
+                                         Arguments...);
+
+        for (int Index = 0; Index < Length
+             && Index < static_cast<int>(sizeof(Buffer)) - 1; ++Index)
+        {
+            Out_String.AppendChar(static_cast<TCHAR>(Buffer[Index]));
+        }
+    }
+
+    /** Appends an integer; the digits get written backwards into a stack
+     *  buffer and appended at once. */
+    template<typename INTEGER>
+    static FORCEINLINE void AppendInteger(FStringBuilderBase& Out_String,
+                                          const INTEGER Value)
+    {
+        TCHAR Buffer[24];
+        TCHAR* const End = Buffer + UE_ARRAY_COUNT(Buffer);
+        TCHAR* Begin = End;
+
+        const bool bNegative = std::is_signed<INTEGER>::value
+                && Value < static_cast<INTEGER>(0);
+        uint64 Magnitude = bNegative ? 0 - static_cast<uint64>(Value)
+                                     : static_cast<uint64>(Value);
+
+        do
+        {
+            *--Begin = static_cast<TCHAR>(TEXT('0') + Magnitude % 10);
+            Magnitude /= 10;
+        }
+        while (Magnitude != 0);
+
+        if (bNegative)
+        {
+            *--Begin = TEXT('-');
+        }
+
+        Out_String.Append(Begin, static_cast<int32>(End - Begin));
+    }
+
+    /** Appends a value with a fixed number of fractional digits, at most six;
+     *  the same output as printf's "%.*f" without going through printf. */
+    static FORCEINLINE void AppendFixed(FStringBuilderBase& Out_String,
+                                        const double Value,
+                                        const int32 Decimals)
+    {
+        static constexpr uint64 SCALES[] = {
+            1, 10, 100, 1000, 10000, 100000, 1000000
+        };
+
+        const uint64 Scale = SCALES[Decimals];
+        const double Scaled = FMath::Abs(Value) * static_cast<double>(Scale);
+
+        /* Huge values and NaNs do not fit the fast path. */
+        if (!(Scaled < 9.0e18))
+        {
+            AppendPrintf(Out_String, "%.*f", Decimals, Value);
+            return;
+        }
+
+        /* Ties round to even, as printf does. */
+        const double Floor = FMath::FloorToDouble(Scaled);
+        const double Remains = Scaled - Floor;
+        uint64 Units = static_cast<uint64>(Floor);
+        if (Remains > 0.5 || (Remains == 0.5 && (Units & 1) != 0))
+        {
+            ++Units;
+        }
+
+        if (Value < 0.0 && Units != 0)
+        {
+            Out_String.AppendChar(TEXT('-'));
+        }
+
+        AppendInteger(Out_String, Units / Scale);
+
+        if (Decimals > 0)
+        {
+            TCHAR Fraction[8];
+            uint64 Remainder = Units % Scale;
+
+            for (int32 Index = Decimals - 1; Index >= 0; --Index)
+            {
+                Fraction[Index] = static_cast<TCHAR>(TEXT('0') + Remainder % 10);
+                Remainder /= 10;
+            }
+
+            Out_String.AppendChar(TEXT('.'));
+            Out_String.Append(Fraction, Decimals);
+        }
+    }
+
+    /** Appends the shortest text which reads back as the very same floating
+     *  point value. Whole numbers take the integer path; the rest go through
+     *  FTLogFloat. */
+    static FORCEINLINE void AppendShortest(FStringBuilderBase& Out_String,
+                                           const double Value,
+                                           const bool bSinglePrecision)
+    {
+        if (FMath::IsFinite(Value) && FMath::Abs(Value) < 1.0e15
+                && Value == FMath::FloorToDouble(Value))
+        {
+            AppendInteger(Out_String, static_cast<int64>(Value));
+            Out_String.Append(TEXT(".0"), 2);
+            return;
+        }
+
+        ANSICHAR Buffer[FTLogFloat::MAX_LENGTH];
+        const int32 Length = FTLogFloat::ToShortest(Value, bSinglePrecision,
+                                                    Buffer);
+
+        AppendChars(Out_String, Buffer, Length);
+    }
+
+    /** Appends a string of a known length of any character type. */
+    template<typename CHAR>
+    static FORCEINLINE void AppendChars(FStringBuilderBase& Out_String,
+                                        const CHAR* Value, const int32 Length)
+    {
+        for (int32 Index = 0; Index < Length; ++Index)
+        {
+            Out_String.AppendChar(static_cast<TCHAR>(Value[Index]));
+        }
+    }
+};
+
 /** This template gives template specialization errors for types that have not
  *  been specialized, yet. */
 template<typename TYPE>
@@ -51,12 +213,12 @@ struct TLogString<TYPE[LENGTH]>
 template <>
 struct TLogString<const AActor*>
 {
-    static void Format(const AActor* Actor, FString& Out_String)
+    static void Format(const AActor* Actor, FStringBuilderBase& Out_String)
     {
         // Guard against NULL values!
         checkf(Actor, TEXT("FATAL: cannot log NULL actor object!"));
 
-        Out_String = FString::Printf(TEXT("%s"), Actor->GetName().GetCharArray().GetData());
+        Actor->GetFName().AppendString(Out_String);
     }
 };
 
@@ -64,12 +226,12 @@ struct TLogString<const AActor*>
 template <>
 struct TLogString<AActor*>
 {
-    static void Format(const AActor* Actor, FString& Out_String)
+    static void Format(const AActor* Actor, FStringBuilderBase& Out_String)
     {
         // Guard against NULL values!
         checkf(Actor, TEXT("FATAL: cannot log NULL actor object!"));
 
-        Out_String = FString::Printf(TEXT("%s"), Actor->GetName().GetCharArray().GetData());
+        Actor->GetFName().AppendString(Out_String);
     }
 };
 
@@ -77,9 +239,9 @@ struct TLogString<AActor*>
 template <>
 struct TLogString<const bool>
 {
-    static void Format(const bool Value, FString& Out_String)
+    static void Format(const bool Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), (Value ? TEXT("True") : TEXT("False")));
+        Out_String.Append(Value ? TEXT("True") : TEXT("False"));
     }
 };
 
@@ -87,9 +249,9 @@ struct TLogString<const bool>
 template <>
 struct TLogString<bool>
 {
-    static void Format(const bool Value, FString& Out_String)
+    static void Format(const bool Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), (Value ? TEXT("True") : TEXT("False")));
+        Out_String.Append(Value ? TEXT("True") : TEXT("False"));
     }
 };
 
@@ -97,9 +259,9 @@ struct TLogString<bool>
 template< std::size_t LENGTH>
 struct TLogString<const char[LENGTH]>
 {
-    static void Format(const char* Value, FString& Out_String)
+    static void Format(const char* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -107,9 +269,9 @@ struct TLogString<const char[LENGTH]>
 template< std::size_t LENGTH>
 struct TLogString<char[LENGTH]>
 {
-    static void Format(const char* Value, FString& Out_String)
+    static void Format(const char* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -117,9 +279,9 @@ struct TLogString<char[LENGTH]>
 template <>
 struct TLogString<const char*>
 {
-    static void Format(const char* Value, FString& Out_String)
+    static void Format(const char* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -127,9 +289,9 @@ struct TLogString<const char*>
 template <>
 struct TLogString<char*>
 {
-    static void Format(const char* Value, FString& Out_String)
+    static void Format(const char* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -139,9 +301,9 @@ struct TLogString<char*>
 template< std::size_t LENGTH>
 struct TLogString<const char16_t[LENGTH]>
 {
-    static void Format(const char16_t* Value, FString& Out_String)
+    static void Format(const char16_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -149,9 +311,9 @@ struct TLogString<const char16_t[LENGTH]>
 template< std::size_t LENGTH>
 struct TLogString<char16_t[LENGTH]>
 {
-    static void Format(const char16_t* Value, FString& Out_String)
+    static void Format(const char16_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -159,9 +321,9 @@ struct TLogString<char16_t[LENGTH]>
 template <>
 struct TLogString<const char16_t*>
 {
-    static void Format(const char16_t* Value, FString& Out_String)
+    static void Format(const char16_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -169,9 +331,9 @@ struct TLogString<const char16_t*>
 template <>
 struct TLogString<char16_t*>
 {
-    static void Format(const char16_t* Value, FString& Out_String)
+    static void Format(const char16_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value).Get());
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -181,14 +343,9 @@ struct TLogString<char16_t*>
 template <>
 struct TLogString<const double>
 {
-    static void Format(const double Value, FString& Out_String)
+    static void Format(const double Value, FStringBuilderBase& Out_String)
     {
-        char Buffer[100];
-        std::snprintf(Buffer, sizeof(Buffer), "%f", Value);
-
-        std::string String(Buffer);
-
-        Out_String = FString(StringCast<WIDECHAR>(String.c_str()).Get());
+        TLogFormat::AppendShortest(Out_String, Value, false);
     }
 };
 
@@ -196,14 +353,9 @@ struct TLogString<const double>
 template <>
 struct TLogString<double>
 {
-    static void Format(const double Value, FString& Out_String)
+    static void Format(const double Value, FStringBuilderBase& Out_String)
     {
-        char Buffer[100];
-        std::snprintf(Buffer, sizeof(Buffer), "%f", Value);
-
-        std::string String(Buffer);
-
-        Out_String = FString(StringCast<WIDECHAR>(String.c_str()).Get());
+        TLogFormat::AppendShortest(Out_String, Value, false);
     }
 };
 
@@ -211,18 +363,19 @@ struct TLogString<double>
 template <>
 struct TLogString<const float>
 {
-    static void Format(const float Value, FString& Out_String)
+    static void Format(const float Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::SanitizeFloat(static_cast<double>(Value), 1);
+        TLogFormat::AppendShortest(Out_String, static_cast<double>(Value), true);
     }
 };
 
 /** Template specialization for float. */
 template <>
-struct TLogString<float> {
-    static void Format(const float Value, FString& Out_String)
+struct TLogString<float>
+{
+    static void Format(const float Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::SanitizeFloat(static_cast<double>(Value), 1);
+        TLogFormat::AppendShortest(Out_String, static_cast<double>(Value), true);
     }
 };
 
@@ -230,9 +383,9 @@ struct TLogString<float> {
 template <>
 struct TLogString<const FName>
 {
-    static void Format(const FName& Value, FString& Out_String)
+    static void Format(const FName& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Value.AppendString(Out_String);
     }
 };
 
@@ -240,9 +393,9 @@ struct TLogString<const FName>
 template <>
 struct TLogString<FName>
 {
-    static void Format(const FName& Value, FString& Out_String)
+    static void Format(const FName& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Value.AppendString(Out_String);
     }
 };
 
@@ -250,9 +403,14 @@ struct TLogString<FName>
 template <>
 struct TLogString<const FRotator>
 {
-    static void Format(const FRotator& Value, FString& Out_String)
+    static void Format(const FRotator& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Out_String.Append(TEXT("P="), 2);
+        TLogFormat::AppendFixed(Out_String, Value.Pitch, 6);
+        Out_String.Append(TEXT(" Y="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Yaw, 6);
+        Out_String.Append(TEXT(" R="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Roll, 6);
     }
 };
 
@@ -260,9 +418,14 @@ struct TLogString<const FRotator>
 template <>
 struct TLogString<FRotator>
 {
-    static void Format(const FRotator& Value, FString& Out_String)
+    static void Format(const FRotator& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Out_String.Append(TEXT("P="), 2);
+        TLogFormat::AppendFixed(Out_String, Value.Pitch, 6);
+        Out_String.Append(TEXT(" Y="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Yaw, 6);
+        Out_String.Append(TEXT(" R="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Roll, 6);
     }
 };
 
@@ -270,9 +433,9 @@ struct TLogString<FRotator>
 template <>
 struct TLogString<const FString>
 {
-    static void Format(const FString& Value, FString& Out_String)
+    static void Format(const FString& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = Value;
+        Out_String.Append(*Value, Value.Len());
     }
 };
 
@@ -280,9 +443,9 @@ struct TLogString<const FString>
 template <>
 struct TLogString<FString>
 {
-    static void Format(const FString& Value, FString& Out_String)
+    static void Format(const FString& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = Value;
+        Out_String.Append(*Value, Value.Len());
     }
 };
 
@@ -290,9 +453,14 @@ struct TLogString<FString>
 template <>
 struct TLogString<const FVector>
 {
-    static void Format(const FVector& Value, FString& Out_String)
+    static void Format(const FVector& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Out_String.Append(TEXT("X="), 2);
+        TLogFormat::AppendFixed(Out_String, Value.X, 3);
+        Out_String.Append(TEXT(" Y="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Y, 3);
+        Out_String.Append(TEXT(" Z="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Z, 3);
     }
 };
 
@@ -300,9 +468,14 @@ struct TLogString<const FVector>
 template <>
 struct TLogString<FVector>
 {
-    static void Format(const FVector& Value, FString& Out_String)
+    static void Format(const FVector& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.ToString().GetCharArray().GetData());
+        Out_String.Append(TEXT("X="), 2);
+        TLogFormat::AppendFixed(Out_String, Value.X, 3);
+        Out_String.Append(TEXT(" Y="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Y, 3);
+        Out_String.Append(TEXT(" Z="), 3);
+        TLogFormat::AppendFixed(Out_String, Value.Z, 3);
     }
 };
 
@@ -310,9 +483,9 @@ struct TLogString<FVector>
 template <>
 struct TLogString<const int8>
 {
-    static void Format(const int8 Value, FString& Out_String)
+    static void Format(const int8 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -320,9 +493,9 @@ struct TLogString<const int8>
 template <>
 struct TLogString<int8>
 {
-    static void Format(const int8 Value, FString& Out_String)
+    static void Format(const int8 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -330,9 +503,9 @@ struct TLogString<int8>
 template <>
 struct TLogString<const int16>
 {
-    static void Format(const int16 Value, FString& Out_String)
+    static void Format(const int16 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -340,9 +513,9 @@ struct TLogString<const int16>
 template <>
 struct TLogString<int16>
 {
-    static void Format(const int16 Value, FString& Out_String)
+    static void Format(const int16 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -350,9 +523,9 @@ struct TLogString<int16>
 template <>
 struct TLogString<const int32>
 {
-    static void Format(const int32 Value, FString& Out_String)
+    static void Format(const int32 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::FromInt(Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -360,9 +533,9 @@ struct TLogString<const int32>
 template <>
 struct TLogString<int32>
 {
-    static void Format(const int32 Value, FString& Out_String)
+    static void Format(const int32 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::FromInt(Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -370,9 +543,9 @@ struct TLogString<int32>
 template <>
 struct TLogString<const int64>
 {
-    static void Format(const int64 Value, FString& Out_String)
+    static void Format(const int64 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -380,9 +553,9 @@ struct TLogString<const int64>
 template <>
 struct TLogString<int64>
 {
-    static void Format(const int64 Value, FString& Out_String)
+    static void Format(const int64 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -390,14 +563,9 @@ struct TLogString<int64>
 template <>
 struct TLogString<const long double>
 {
-    static void Format(const long double Value, FString& Out_String)
+    static void Format(const long double Value, FStringBuilderBase& Out_String)
     {
-        char Buffer[100];
-        std::snprintf(Buffer, sizeof(Buffer), "%Lf", Value);
-
-        std::string String(Buffer);
-
-        Out_String = FString(StringCast<WIDECHAR>(String.c_str()).Get());
+        TLogFormat::AppendPrintf(Out_String, "%Lf", Value);
     }
 };
 
@@ -405,14 +573,9 @@ struct TLogString<const long double>
 template <>
 struct TLogString<long double>
 {
-    static void Format(const long double Value, FString& Out_String)
+    static void Format(const long double Value, FStringBuilderBase& Out_String)
     {
-        char Buffer[100];
-        std::snprintf(Buffer, sizeof(Buffer), "%Lf", Value);
-
-        std::string String(Buffer);
-
-        Out_String = FString(StringCast<WIDECHAR>(String.c_str()).Get());
+        TLogFormat::AppendPrintf(Out_String, "%Lf", Value);
     }
 };
 
@@ -422,9 +585,9 @@ struct TLogString<long double>
 template <>
 struct TLogString<const std::size_t>
 {
-    static void Format(const std::size_t Value, FString& Out_String)
+    static void Format(const std::size_t Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -436,9 +599,9 @@ struct TLogString<const std::size_t>
 template <>
 struct TLogString<std::size_t>
 {
-    static void Format(const std::size_t Value, FString& Out_String)
+    static void Format(const std::size_t Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -448,9 +611,9 @@ struct TLogString<std::size_t>
 template <>
 struct TLogString<const uint8>
 {
-    static void Format(const int8 Value, FString& Out_String)
+    static void Format(const uint8 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -458,9 +621,9 @@ struct TLogString<const uint8>
 template <>
 struct TLogString<uint8>
 {
-    static void Format(const int8 Value, FString& Out_String)
+    static void Format(const uint8 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -468,9 +631,9 @@ struct TLogString<uint8>
 template <>
 struct TLogString<const uint16>
 {
-    static void Format(const int16 Value, FString& Out_String)
+    static void Format(const uint16 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -478,9 +641,9 @@ struct TLogString<const uint16>
 template <>
 struct TLogString<uint16>
 {
-    static void Format(const int16 Value, FString& Out_String)
+    static void Format(const uint16 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -488,9 +651,9 @@ struct TLogString<uint16>
 template <>
 struct TLogString<const uint32>
 {
-    static void Format(const int32 Value, FString& Out_String)
+    static void Format(const uint32 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -498,9 +661,9 @@ struct TLogString<const uint32>
 template <>
 struct TLogString<uint32>
 {
-    static void Format(const int32 Value, FString& Out_String)
+    static void Format(const uint32 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -508,9 +671,9 @@ struct TLogString<uint32>
 template <>
 struct TLogString<const uint64>
 {
-    static void Format(const int64 Value, FString& Out_String)
+    static void Format(const uint64 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -518,9 +681,9 @@ struct TLogString<const uint64>
 template <>
 struct TLogString<uint64>
 {
-    static void Format(const int64 Value, FString& Out_String)
+    static void Format(const uint64 Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%d"), Value);
+        TLogFormat::AppendInteger(Out_String, Value);
     }
 };
 
@@ -528,9 +691,10 @@ struct TLogString<uint64>
 template <>
 struct TLogString<const std::string>
 {
-    static void Format(const std::string& Value, FString& Out_String)
+    static void Format(const std::string& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value.c_str()).Get());
+        TLogFormat::AppendChars(Out_String, Value.c_str(),
+                                static_cast<int32>(Value.size()));
     }
 };
 
@@ -538,9 +702,10 @@ struct TLogString<const std::string>
 template <>
 struct TLogString<std::string>
 {
-    static void Format(const std::string& Value, FString& Out_String)
+    static void Format(const std::string& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString(StringCast<WIDECHAR>(Value.c_str()).Get());
+        TLogFormat::AppendChars(Out_String, Value.c_str(),
+                                static_cast<int32>(Value.size()));
     }
 };
 
@@ -548,9 +713,9 @@ struct TLogString<std::string>
 template<std::size_t LENGTH>
 struct TLogString<const wchar_t[LENGTH]>
 {
-    static void Format(const wchar_t* Value, FString& Out_String)
+    static void Format(const wchar_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value);
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -558,9 +723,9 @@ struct TLogString<const wchar_t[LENGTH]>
 template<std::size_t LENGTH>
 struct TLogString<wchar_t[LENGTH]>
 {
-    static void Format(const wchar_t* Value, FString& Out_String)
+    static void Format(const wchar_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value);
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -568,9 +733,9 @@ struct TLogString<wchar_t[LENGTH]>
 template <>
 struct TLogString<const wchar_t*>
 {
-    static void Format(const wchar_t* Value, FString& Out_String)
+    static void Format(const wchar_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value);
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -578,9 +743,9 @@ struct TLogString<const wchar_t*>
 template <>
 struct TLogString<wchar_t*>
 {
-    static void Format(const wchar_t* Value, FString& Out_String)
+    static void Format(const wchar_t* Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value);
+        TLogFormat::AppendChars(Out_String, Value);
     }
 };
 
@@ -588,9 +753,10 @@ struct TLogString<wchar_t*>
 template <>
 struct TLogString<const std::wstring>
 {
-    static void Format(const std::wstring& Value, FString& Out_String)
+    static void Format(const std::wstring& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.c_str());
+        TLogFormat::AppendChars(Out_String, Value.c_str(),
+                                static_cast<int32>(Value.size()));
     }
 };
 
@@ -598,12 +764,15 @@ struct TLogString<const std::wstring>
 template <>
 struct TLogString<std::wstring>
 {
-    static void Format(const std::wstring& Value, FString& Out_String)
+    static void Format(const std::wstring& Value, FStringBuilderBase& Out_String)
     {
-        Out_String = FString::Printf(TEXT("%s"), Value.c_str());
+        TLogFormat::AppendChars(Out_String, Value.c_str(),
+                                static_cast<int32>(Value.size()));
     }
 };
 
+struct TLogSite;
+
 /** A generic LOG class which prints logs on both screen and log file for
  *  debug or development builds and eliminates the logs automatically from
  *  release builds. */
@@ -653,156 +822,263 @@ public:
         Player
     };
 
-private:
-    /** Opaque pointer for private static stuff. */
-    struct StaticImpl;
-    struct StaticImplDeleter
+public:
+    /** Determines whether an entry would get emitted or not. It is cheap
+     *  enough to run before the entry gets constructed or formatted. Fatal
+     *  entries are always emitted; the rest have to pass both the engine's
+     *  log category and the runtime filter. */
+    static FORCEINLINE bool IsEnabled(const EVerbosity& Verbosity,
+                                      const ECategory& Category,
+                                      const uint64 Key)
     {
-        void operator()(StaticImpl* Pointer);
-    };
-    static std::unique_ptr<StaticImpl, StaticImplDeleter> SPimpl;
-    static StaticImplDeleter SPimplDeleter;
+        if (Verbosity == EVerbosity::Fatal)
+        {
+            return true;
+        }
+
+        const ELogVerbosity::Type LogVerbosity = ToLogVerbosity(Verbosity);
+        bool bSuppressed = true;
+
+        switch (Category)
+        {
+        case ECategory::AI:
+            bSuppressed = Log_AI.IsSuppressed(LogVerbosity);
+            break;
+        case ECategory::Generic:
+            bSuppressed = Log_Generic.IsSuppressed(LogVerbosity);
+            break;
+        case ECategory::Input:
+            bSuppressed = Log_Input.IsSuppressed(LogVerbosity);
+            break;
+        case ECategory::Player:
+            bSuppressed = Log_Player.IsSuppressed(LogVerbosity);
+            break;
+        }
+
+        return !bSuppressed && FTLogFilter::Passes(static_cast<uint8>(Verbosity),
+                                                   static_cast<uint8>(Category),
+                                                   Key);
+    }
 
-    /** Opaque pointer for static stuff. */
-    struct Impl;
-    struct ImplDeleter
+    /** Maps a verbosity to the engine's log verbosity. */
+    static constexpr ELogVerbosity::Type ToLogVerbosity(
+            const EVerbosity& Verbosity)
     {
-        void operator()(Impl* Pointer);
-    };
-    std::unique_ptr<Impl, ImplDeleter> Pimpl;
-    ImplDeleter PimplDeleter;
+        return Verbosity == EVerbosity::Fatal ? ELogVerbosity::Fatal
+                : Verbosity == EVerbosity::Error ? ELogVerbosity::Error
+                : Verbosity == EVerbosity::Warning ? ELogVerbosity::Warning
+                : Verbosity == EVerbosity::Display ? ELogVerbosity::Display
+                : Verbosity == EVerbosity::Log ? ELogVerbosity::Log
+                : Verbosity == EVerbosity::Verbose ? ELogVerbosity::Verbose
+                : ELogVerbosity::VeryVerbose;
+    }
+
+    /** Returns the tag a verbosity is printed with, e.g. WARNING. */
+    static const TCHAR* GetTag(const EVerbosity& Verbosity);
+
+    /** Returns the color a verbosity is shown on screen with. */
+    static const FColor& GetColor(const EVerbosity& Verbosity);
 
 private:
-    FString Buffer;
+    /** The call site this entry is logged from. */
+    const TLogSite* Site;
+
+    /** The entry being assembled; lives on the stack of the logging thread
+     *  unless it outgrows the inline buffer. */
+    TStringBuilder<TLOG_INLINE_BUFFER_SIZE> Buffer;
     bool bAnyEntries;
 
+    /** Whether the arguments get recorded in binary form instead of text. */
+    bool bBinary;
+
+    /** The time the entry was logged at; the log writer merges the entries
+     *  of all the logging threads in this order. */
+    uint64 Cycles;
+
+    /** The encoded arguments of a binary entry. */
+    FTLogPayload Payload;
+
 public:
-    TLogCore(const EVerbosity& Verbosity,
-         const ECategory& Category,
-         const uint64 Key,
-         const std::string& File,
-         const std::string& Function,
-         const int32 Line);
+    explicit TLogCore(const TLogSite& CallSite);
     virtual ~TLogCore();
 
+public:
+    /** Writes a finished entry to the log file; safe to call from any thread.
+     *  The log writer thread calls this for the entries it drains. */
+    static void WriteToLog(const TLogSite& CallSite, const TCHAR* Entry);
+
+    /** Shows a finished entry on screen; does nothing outside the game
+     *  thread. */
+    static void WriteOnScreen(const TLogSite& CallSite, const TCHAR* Entry);
+
 public:
     template <typename TYPE>
     TLogCore& operator,(const TYPE& Argument)
     {
+        if (bBinary)
+        {
+            TLogBinary<TYPE>::Encode(Argument, Payload);
+            return *this;
+        }
+
         if (bAnyEntries)
         {
-            Buffer += FString(TEXT(" • "));
+            Buffer.Append(TEXT(" • "));
         }
 
-        FString FormattedArgument;
-        TLogString<TYPE>::Format(Argument, FormattedArgument);
-        Buffer += FormattedArgument;
+        TLogString<TYPE>::Format(Argument, Buffer);
         bAnyEntries = true;
 
         return *this;
     }
 };
 
+/** Describes a log call site. Every TLOG_* statement owns a static constexpr
+ *  instance, so the file, function, line, and the rest never get converted or
+ *  copied per call. */
+struct TLogSite
+{
+    const ANSICHAR* File;
+    const ANSICHAR* Function;
+    int32 Line;
+    TLogCore::EVerbosity Verbosity;
+    TLogCore::ECategory Category;
+    uint64 Key;
+};
+
+/* Logging macros core. When logging is enabled the verbosity and category
+ * check runs before the log entry gets constructed or any of the arguments
+ * get evaluated. When logging is disabled the macros expand to nothing, except
+ * for the fatal ones which still crash. */
+
+#if defined ( HIDEANDSEEKWITHAI_LOGGING )
+
+#define TLOG_IMPL( Verbosity, Category, Key, ... )  \
+    do  \
+    {  \
+        if (TLogCore::IsEnabled(TLogCore::EVerbosity::Verbosity, TLogCore::ECategory::Category, Key))  \
+        {  \
+            static constexpr TLogSite TLogCallSite {  \
+                __FILE__, __FUNCTION__, __LINE__,  \
+                TLogCore::EVerbosity::Verbosity, TLogCore::ECategory::Category, Key };  \
+            (TLogCore(TLogCallSite)), __VA_ARGS__;  \
+        }  \
+    }  \
+    while (false)
+
+#define TLOG_FATAL_IMPL( Category, Key, ... )  \
+    TLOG_IMPL( Fatal, Category, Key, __VA_ARGS__ )
+
+#else
+
+#define TLOG_IMPL( Verbosity, Category, Key, ... )  \
+    ((void)0)
+
+#define TLOG_FATAL_IMPL( Category, Key, ... )  \
+    UE_LOG(Log_##Category, Fatal, TEXT("[FATAL %s %d] key: %llu"), ANSI_TO_TCHAR(__FILE__), __LINE__, static_cast<uint64>(Key))
+
+#endif  /* defined ( HIDEANDSEEKWITHAI_LOGGING ) */
+
 /* Generic logging macros */
 
 #define TLOG_FATAL( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Fatal, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_FATAL_IMPL( Generic, Key, __VA_ARGS__ )
 
 #define TLOG_ERROR( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Error, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Error, Generic, Key, __VA_ARGS__ )
 
 #define TLOG_WARNING( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Warning, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Warning, Generic, Key, __VA_ARGS__ )
 
 #define TLOG_DISPLAY( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Display, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Display, Generic, Key, __VA_ARGS__ )
 
 #define TLOG_LOG( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Generic, Key, __VA_ARGS__ )
 
 #define TLOG_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Verbose, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Verbose, Generic, Key, __VA_ARGS__ )
 
 #define TLOG_VERY_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::VeryVerbose, TLogCore::ECategory::Generic, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( VeryVerbose, Generic, Key, __VA_ARGS__ )
 
 #define TLOG( ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Generic, TLOG_KEY_INFINITE, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Generic, TLOG_KEY_INFINITE, __VA_ARGS__ )
 
 /* AI logging macros */
 
 #define TLOG_AI_FATAL( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Fatal, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_FATAL_IMPL( AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_ERROR( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Error, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Error, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_WARNING( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Warning, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Warning, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_DISPLAY( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Display, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Display, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_LOG( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Verbose, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Verbose, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI_VERY_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::VeryVerbose, TLogCore::ECategory::AI, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( VeryVerbose, AI, Key, __VA_ARGS__ )
 
 #define TLOG_AI( ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::AI, TLOG_KEY_INFINITE, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, AI, TLOG_KEY_INFINITE, __VA_ARGS__ )
 
 /* Input logging macros */
 
 #define TLOG_INPUT_FATAL( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Fatal, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_FATAL_IMPL( Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_ERROR( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Error, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Error, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_WARNING( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Warning, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Warning, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_DISPLAY( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Display, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Display, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_LOG( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Verbose, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Verbose, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT_VERY_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::VeryVerbose, TLogCore::ECategory::Input, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( VeryVerbose, Input, Key, __VA_ARGS__ )
 
 #define TLOG_INPUT( ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Input, TLOG_KEY_INFINITE, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Input, TLOG_KEY_INFINITE, __VA_ARGS__ )
 
 /* Player logging macros */
 
 #define TLOG_PLAYER_FATAL( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Fatal, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_FATAL_IMPL( Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_ERROR( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Error, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Error, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_WARNING( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Warning, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Warning, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_DISPLAY( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Display, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Display, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_LOG( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::Verbose, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Verbose, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER_VERY_VERBOSE( Key, ... )  \
-    (TLogCore(TLogCore::EVerbosity::VeryVerbose, TLogCore::ECategory::Player, Key, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( VeryVerbose, Player, Key, __VA_ARGS__ )
 
 #define TLOG_PLAYER( ... )  \
-    (TLogCore(TLogCore::EVerbosity::Log, TLogCore::ECategory::Player, TLOG_KEY_INFINITE, __FILE__, __FUNCTION__, __LINE__)), __VA_ARGS__;
+    TLOG_IMPL( Log, Player, TLOG_KEY_INFINITE, __VA_ARGS__ )
@@ -0,0 +1,237 @@
+#include "TLogBinary.h"
+#include "HideAndSeekWithAI.h"
+
+#include <GenericPlatform/GenericPlatformFile.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/PlatformFilemanager.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/CommandLine.h>
+#include <Misc/DateTime.h>
+#include <Misc/Parse.h>
+#include <Misc/Paths.h>
+
+#include "TLog.h"
+
+/** The longest string an argument keeps; the rest gets cut. */
+static constexpr int32 MAX_STRING_LENGTH = TNumericLimits<uint16>::Max();
+
+static TAutoConsoleVariable<int32> CVarLogBinary(
+        TEXT("t.Log.Binary"),
+        0,
+        TEXT("Records the log entries in binary form into Saved/Logs; run the"
+             " TLogDecode commandlet to read them.\n"
+             " 0: off\n"
+             " 1: on"),
+        ECVF_Default);
+
+/** Appends a string with its length first. */
+template<typename ALLOCATOR>
+static void WriteLengthPrefixed(TArray<uint8, ALLOCATOR>& Out_Bytes,
+                                const ANSICHAR* Data, const int32 Length)
+{
+    const uint16 ClampedLength =
+            static_cast<uint16>(FMath::Min(Length, MAX_STRING_LENGTH));
+
+    FTLogBinary::Write(Out_Bytes, ClampedLength);
+    Out_Bytes.Append(reinterpret_cast<const uint8*>(Data), ClampedLength);
+}
+
+bool FTLogBinary::IsEnabled()
+{
+    static const bool bCommandLine =
+            FParse::Param(FCommandLine::Get(), TEXT("TLogBinary"));
+
+    return bCommandLine || CVarLogBinary.GetValueOnAnyThread() != 0;
+}
+
+void FTLogBinary::WriteAnsiString(FTLogPayload& Out_Bytes, const char* Value)
+{
+    Write(Out_Bytes, EArgument::AnsiString);
+    WriteLengthPrefixed(Out_Bytes, Value,
+                        static_cast<int32>(std::strlen(Value)));
+}
+
+void FTLogBinary::WriteString(FTLogPayload& Out_Bytes, const TCHAR* Value)
+{
+    const FTCHARToUTF8 Utf8(Value);
+
+    Write(Out_Bytes, EArgument::String);
+    WriteLengthPrefixed(Out_Bytes, Utf8.Get(), Utf8.Length());
+}
+
+FTLogBinarySink::FTLogBinarySink(const uint64 StartCycles,
+                                 const FDateTime& StartTime)
+{
+    const FString Path(FPaths::ProjectLogDir()
+                       / FString::Printf(TEXT("TLog-%s%s"),
+                                         *FDateTime::Now().ToString(),
+                                         FTLogBinary::EXTENSION));
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::ProjectLogDir());
+    File.Reset(PlatformFile.OpenWrite(*Path));
+
+    if (!File)
+    {
+        UE_LOG(Log_Generic, Error,
+               TEXT("[ERROR TLog] cannot open the binary log '%s'!"), *Path);
+        return;
+    }
+
+    FTLogBinary::Write(Block, FTLogBinary::MAGIC);
+    FTLogBinary::Write(Block, FTLogBinary::VERSION);
+    FTLogBinary::Write(Block, FPlatformTime::GetSecondsPerCycle64());
+    FTLogBinary::Write(Block, StartCycles);
+    FTLogBinary::Write(Block, StartTime.GetTicks());
+    Flush();
+
+    UE_LOG(Log_Generic, Display,
+           TEXT("[DISPLAY TLog] recording the binary log into '%s'."), *Path);
+}
+
+FTLogBinarySink::~FTLogBinarySink()
+{
+    Flush();
+}
+
+void FTLogBinarySink::Write(const TLogSite& Site, const uint64 Cycles,
+                            const TArrayView<const uint8> Payload)
+{
+    if (!File)
+    {
+        return;
+    }
+
+    const uint32 SiteId = GetSiteId(Site);
+
+    /* Names and actors refer to the name records in the file instead of the
+     * name table of the running process. */
+    FilePayload.Reset();
+
+    int32 Offset = 0;
+    while (Offset < Payload.Num())
+    {
+        const FTLogBinary::EArgument Type =
+                static_cast<FTLogBinary::EArgument>(Payload[Offset]);
+        const uint8* Data = Payload.GetData() + Offset + 1;
+        int32 Size = 0;
+
+        FilePayload.Add(Payload[Offset]);
+
+        switch (Type)
+        {
+        case FTLogBinary::EArgument::Bool:
+            Size = sizeof(uint8);
+            break;
+
+        case FTLogBinary::EArgument::Int:
+        case FTLogBinary::EArgument::UInt:
+        case FTLogBinary::EArgument::Double:
+            Size = sizeof(uint64);
+            break;
+
+        case FTLogBinary::EArgument::Float:
+            Size = sizeof(float);
+            break;
+
+        case FTLogBinary::EArgument::Vector:
+            Size = sizeof(FVector);
+            break;
+
+        case FTLogBinary::EArgument::Rotator:
+            Size = sizeof(FRotator);
+            break;
+
+        case FTLogBinary::EArgument::Name:
+        {
+            FName Name;
+            std::memcpy(&Name, Data, sizeof(FName));
+            FTLogBinary::Write(FilePayload, GetNameId(Name));
+            Offset += 1 + sizeof(FName);
+        }
+            continue;
+
+        case FTLogBinary::EArgument::Actor:
+        {
+            FName Name;
+            std::memcpy(&Name, Data + sizeof(uint32), sizeof(FName));
+            FilePayload.Append(Data, sizeof(uint32));
+            FTLogBinary::Write(FilePayload, GetNameId(Name));
+            Offset += 1 + sizeof(uint32) + sizeof(FName);
+        }
+            continue;
+
+        case FTLogBinary::EArgument::AnsiString:
+        case FTLogBinary::EArgument::String:
+        {
+            uint16 Length = 0;
+            std::memcpy(&Length, Data, sizeof(uint16));
+            Size = sizeof(uint16) + Length;
+        }
+            break;
+        }
+
+        FilePayload.Append(Data, Size);
+        Offset += 1 + Size;
+    }
+
+    FTLogBinary::Write(Block, FTLogBinary::ERecord::Entry);
+    FTLogBinary::Write(Block, SiteId);
+    FTLogBinary::Write(Block, Cycles);
+    FTLogBinary::Write(Block, static_cast<uint32>(FilePayload.Num()));
+    Block.Append(FilePayload);
+}
+
+void FTLogBinarySink::Flush()
+{
+    if (File && Block.Num() > 0)
+    {
+        File->Write(Block.GetData(), Block.Num());
+        File->Flush();
+    }
+
+    Block.Reset();
+}
+
+uint32 FTLogBinarySink::GetSiteId(const TLogSite& Site)
+{
+    if (const uint32* SiteId = SiteIds.Find(&Site))
+    {
+        return *SiteId;
+    }
+
+    const uint32 NewSiteId = static_cast<uint32>(SiteIds.Num());
+    SiteIds.Add(&Site, NewSiteId);
+
+    FTLogBinary::Write(Block, FTLogBinary::ERecord::Site);
+    FTLogBinary::Write(Block, NewSiteId);
+    FTLogBinary::Write(Block, static_cast<uint8>(Site.Verbosity));
+    FTLogBinary::Write(Block, static_cast<uint8>(Site.Category));
+    FTLogBinary::Write(Block, Site.Key);
+    FTLogBinary::Write(Block, Site.Line);
+    WriteLengthPrefixed(Block, Site.File,
+                        static_cast<int32>(std::strlen(Site.File)));
+    WriteLengthPrefixed(Block, Site.Function,
+                        static_cast<int32>(std::strlen(Site.Function)));
+
+    return NewSiteId;
+}
+
+uint32 FTLogBinarySink::GetNameId(const FName& Name)
+{
+    if (const uint32* NameId = NameIds.Find(Name))
+    {
+        return *NameId;
+    }
+
+    const uint32 NewNameId = static_cast<uint32>(NameIds.Num());
+    NameIds.Add(Name, NewNameId);
+
+    const FTCHARToUTF8 Utf8(*Name.ToString());
+
+    FTLogBinary::Write(Block, FTLogBinary::ERecord::Name);
+    FTLogBinary::Write(Block, NewNameId);
+    WriteLengthPrefixed(Block, Utf8.Get(), Utf8.Length());
+
+    return NewNameId;
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstring>
+
+#include <Containers/Array.h>
+#include <Containers/ArrayView.h>
+#include <Containers/ContainerAllocationPolicies.h>
+#include <Containers/Map.h>
+#include <Containers/StringConv.h>
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <GameFramework/Actor.h>
+#include <Math/Rotator.h>
+#include <Math/Vector.h>
+#include <Misc/StringBuilder.h>
+#include <Templates/UniquePtr.h>
+#include <UObject/NameTypes.h>
+
+template<typename TYPE>
+struct TLogString;
+
+/** The size of the inline buffer the arguments of a binary entry get encoded
+ *  in; larger payloads spill to the heap. */
+static constexpr int32 TLOG_INLINE_PAYLOAD_SIZE = 256;
+
+/** The encoded arguments of a binary entry. */
+using FTLogPayload = TArray<uint8, TInlineAllocator<TLOG_INLINE_PAYLOAD_SIZE>>;
+
+/** The binary TLog format. Instead of formatting the entries into text, the
+ *  binary sink records the call site, the time stamp and the raw argument
+ *  values of every entry into an append-only file under Saved/Logs; the
+ *  'TLogDecode' commandlet turns the file back into text or CSV.
+ *
+ *  A file starts with a header (magic, version, seconds per cycle, start
+ *  cycles and start time) followed by the records. Every record starts with
+ *  its record type:
+ *    - Site:  id, verbosity, category, key, line, file and function; written
+ *             once, before the first entry logged from the site.
+ *    - Name:  id and text; written once, before the first entry using it.
+ *    - Entry: site id, cycles, payload size and payload.
+ *
+ *  The payload is a sequence of arguments, each one starting with its type.
+ *  Names and actors refer to the name records by id; strings are stored as
+ *  UTF-8.
+ *
+ *  The binary sink is off by default; pass '-TLogBinary' on the command line
+ *  or set 't.Log.Binary 1' to turn it on. Errors and fatal errors are still
+ *  written as text. */
+struct HIDEANDSEEKWITHAI_API FTLogBinary
+{
+    /** The first four bytes of every binary log file; 'TLOG'. */
+    static constexpr uint32 MAGIC = 0x474F4C54;
+
+    /** The format version; bumped on every incompatible change. */
+    static constexpr uint16 VERSION = 1;
+
+    /** The file extension of the binary log files. */
+    static constexpr const TCHAR* EXTENSION = TEXT(".tlog");
+
+    /** The record types. */
+    enum class ERecord : uint8
+    {
+        Site,
+        Name,
+        Entry
+    };
+
+    /** The argument types inside an entry payload. */
+    enum class EArgument : uint8
+    {
+        Bool,
+        Int,
+        UInt,
+        Float,
+        Double,
+        Vector,
+        Rotator,
+        Name,
+        Actor,
+        AnsiString,
+        String
+    };
+
+    /** Determines whether the entries get recorded in binary form or not. */
+    static bool IsEnabled();
+
+    /** Appends the raw bytes of a plain value. */
+    template<typename ALLOCATOR, typename TYPE>
+    static FORCEINLINE void Write(TArray<uint8, ALLOCATOR>& Out_Bytes,
+                                  const TYPE& Value)
+    {
+        const int32 Offset = Out_Bytes.AddUninitialized(sizeof(TYPE));
+        std::memcpy(Out_Bytes.GetData() + Offset, &Value, sizeof(TYPE));
+    }
+
+    /** Appends an argument type followed by its raw value. */
+    template<typename TYPE>
+    static FORCEINLINE void WriteArgument(FTLogPayload& Out_Bytes,
+                                          const EArgument& Type,
+                                          const TYPE& Value)
+    {
+        Write(Out_Bytes, Type);
+        Write(Out_Bytes, Value);
+    }
+
+    /** Appends an ANSI string argument; its length comes first. */
+    static void WriteAnsiString(FTLogPayload& Out_Bytes, const char* Value);
+
+    /** Appends a string argument as UTF-8; its length comes first. */
+    static void WriteString(FTLogPayload& Out_Bytes, const TCHAR* Value);
+};
+
+/** Encodes a log argument into an entry payload. Types without a
+ *  specialization get formatted by TLogString and stored as strings. */
+template<typename TYPE>
+struct TLogBinary
+{
+    static void Encode(const TYPE& Value, FTLogPayload& Out_Payload)
+    {
+        TStringBuilder<TLOG_INLINE_PAYLOAD_SIZE> String;
+        TLogString<TYPE>::Format(Value, String);
+        FTLogBinary::WriteString(Out_Payload, String.ToString());
+    }
+};
+
+/** Template specialization for const AActor*. */
+template <>
+struct TLogBinary<const AActor*>
+{
+    static void Encode(const AActor* Actor, FTLogPayload& Out_Payload)
+    {
+        // Guard against NULL values!
+        checkf(Actor, TEXT("FATAL: cannot log NULL actor object!"));
+
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Actor,
+                                   Actor->GetUniqueID());
+        FTLogBinary::Write(Out_Payload, Actor->GetFName());
+    }
+};
+
+/** Template specialization for AActor*. */
+template <>
+struct TLogBinary<AActor*>
+{
+    static void Encode(const AActor* Actor, FTLogPayload& Out_Payload)
+    {
+        TLogBinary<const AActor*>::Encode(Actor, Out_Payload);
+    }
+};
+
+/** Template specialization for bool. */
+template <>
+struct TLogBinary<bool>
+{
+    static void Encode(const bool Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Bool,
+                                   static_cast<uint8>(Value));
+    }
+};
+
+/** Template specialization for char[]. */
+template< std::size_t LENGTH>
+struct TLogBinary<char[LENGTH]>
+{
+    static void Encode(const char* Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteAnsiString(Out_Payload, Value);
+    }
+};
+
+/** Template specialization for const char*. */
+template <>
+struct TLogBinary<const char*>
+{
+    static void Encode(const char* Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteAnsiString(Out_Payload, Value);
+    }
+};
+
+/** Template specialization for char*. */
+template <>
+struct TLogBinary<char*>
+{
+    static void Encode(const char* Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteAnsiString(Out_Payload, Value);
+    }
+};
+
+/** Template specialization for double. */
+template <>
+struct TLogBinary<double>
+{
+    static void Encode(const double Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Double,
+                                   Value);
+    }
+};
+
+/** Template specialization for float. */
+template <>
+struct TLogBinary<float>
+{
+    static void Encode(const float Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Float,
+                                   Value);
+    }
+};
+
+/** Template specialization for FName. */
+template <>
+struct TLogBinary<FName>
+{
+    static void Encode(const FName& Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Name,
+                                   Value);
+    }
+};
+
+/** Template specialization for FRotator. */
+template <>
+struct TLogBinary<FRotator>
+{
+    static void Encode(const FRotator& Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Rotator,
+                                   Value);
+    }
+};
+
+/** Template specialization for FString. */
+template <>
+struct TLogBinary<FString>
+{
+    static void Encode(const FString& Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteString(Out_Payload, *Value);
+    }
+};
+
+/** Template specialization for FVector. */
+template <>
+struct TLogBinary<FVector>
+{
+    static void Encode(const FVector& Value, FTLogPayload& Out_Payload)
+    {
+        FTLogBinary::WriteArgument(Out_Payload, FTLogBinary::EArgument::Vector,
+                                   Value);
+    }
+};
+
+/** Template specializations for the integer types; stored as 64-bit. */
+#define TLOG_BINARY_INTEGER( TYPE, ARGUMENT, STORAGE )  \
+    template <>  \
+    struct TLogBinary<TYPE>  \
+    {  \
+        static void Encode(const TYPE Value, FTLogPayload& Out_Payload)  \
+        {  \
+            FTLogBinary::WriteArgument(Out_Payload,  \
+                                       FTLogBinary::EArgument::ARGUMENT,  \
+                                       static_cast<STORAGE>(Value));  \
+        }  \
+    };
+
+TLOG_BINARY_INTEGER( int8, Int, int64 )
+TLOG_BINARY_INTEGER( int16, Int, int64 )
+TLOG_BINARY_INTEGER( int32, Int, int64 )
+TLOG_BINARY_INTEGER( int64, Int, int64 )
+TLOG_BINARY_INTEGER( uint8, UInt, uint64 )
+TLOG_BINARY_INTEGER( uint16, UInt, uint64 )
+TLOG_BINARY_INTEGER( uint32, UInt, uint64 )
+TLOG_BINARY_INTEGER( uint64, UInt, uint64 )
+
+#undef TLOG_BINARY_INTEGER
+
+class IFileHandle;
+struct FDateTime;
+struct TLogSite;
+
+/** Writes the binary entries drained by the log writer into a new file under
+ *  Saved/Logs. The call sites and names are written once, the first time an
+ *  entry refers to them. Only the log writer thread touches the sink. */
+class HIDEANDSEEKWITHAI_API FTLogBinarySink
+{
+public:
+    /** Opens a new file whose time stamps count from StartCycles, which has
+     *  to precede every entry written to it. */
+    FTLogBinarySink(const uint64 StartCycles, const FDateTime& StartTime);
+    ~FTLogBinarySink();
+
+    /** Appends an entry; the payload holds the encoded arguments. */
+    void Write(const TLogSite& Site, const uint64 Cycles,
+               const TArrayView<const uint8> Payload);
+
+    /** Writes the pending records to the file. */
+    void Flush();
+
+private:
+    /** Returns the id of a call site, writing its record first if needed. */
+    uint32 GetSiteId(const TLogSite& Site);
+
+    /** Returns the id of a name, writing its record first if needed. */
+    uint32 GetNameId(const FName& Name);
+
+private:
+    /** The file being written, or nullptr if it could not be opened. */
+    TUniquePtr<IFileHandle> File;
+
+    /** The records waiting to be written to the file. */
+    TArray<uint8> Block;
+
+    /** The payload of the entry being written, as it goes to the file. */
+    TArray<uint8> FilePayload;
+
+    /** The ids of the call sites written so far. */
+    TMap<const TLogSite*, uint32> SiteIds;
+
+    /** The ids of the names written so far. */
+    TMap<FName, uint32> NameIds;
+};
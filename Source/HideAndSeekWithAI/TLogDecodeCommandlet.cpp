@@ -0,0 +1,518 @@
+#include "TLogDecodeCommandlet.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Containers/Map.h>
+#include <GenericPlatform/GenericPlatformFile.h>
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFilemanager.h>
+#include <Misc/DateTime.h>
+#include <Misc/Parse.h>
+#include <Misc/Paths.h>
+#include <Serialization/Archive.h>
+#include <Templates/UniquePtr.h>
+
+#include "TLog.h"
+
+/** The number of bytes read from the binary log at once. */
+static constexpr int32 READ_CHUNK_SIZE = 1 << 20;
+
+/** The category names, in the order of TLogCore::ECategory. */
+static const TCHAR* const CATEGORY_NAMES[] = {
+    TEXT("AI"),
+    TEXT("Generic"),
+    TEXT("Input"),
+    TEXT("Player")
+};
+
+/** A call site record read back from the file. */
+struct FTDecodedSite
+{
+    uint8 Verbosity;
+    uint8 Category;
+    uint64 Key;
+    int32 Line;
+    FString File;
+    FString Function;
+};
+
+/** Reads the values out of the binary log in order, a chunk of the file at a
+ *  time, so the size of the log does not matter; any read past the end marks
+ *  the reader as failed. */
+class FTLogBinaryReader
+{
+private:
+    TUniquePtr<IFileHandle> File;
+    int64 FileSize;
+
+    /* The bytes read from the file so far but not consumed yet start at
+     * WindowOffset; the window starts at WindowStart inside the file. */
+    TArray<uint8> Window;
+    int32 WindowOffset;
+    int64 WindowStart;
+
+    bool bFailed;
+
+public:
+    explicit FTLogBinaryReader(IFileHandle* InFile)
+        : File(InFile),
+          FileSize(InFile ? InFile->Size() : 0),
+          WindowOffset(0),
+          WindowStart(0),
+          bFailed(InFile == nullptr)
+    {
+
+    }
+
+    FORCEINLINE bool IsAtEnd() const
+    {
+        return bFailed || GetOffset() >= FileSize;
+    }
+
+    FORCEINLINE bool HasFailed() const
+    {
+        return bFailed;
+    }
+
+    FORCEINLINE int64 GetOffset() const
+    {
+        return WindowStart + WindowOffset;
+    }
+
+    FORCEINLINE int64 GetSize() const
+    {
+        return FileSize;
+    }
+
+    template<typename TYPE>
+    TYPE Read()
+    {
+        TYPE Value{};
+
+        if (!Ensure(static_cast<int32>(sizeof(TYPE))))
+        {
+            return Value;
+        }
+
+        std::memcpy(&Value, Window.GetData() + WindowOffset, sizeof(TYPE));
+        WindowOffset += sizeof(TYPE);
+
+        return Value;
+    }
+
+    FString ReadString()
+    {
+        const uint16 Length = Read<uint16>();
+
+        if (!Ensure(Length))
+        {
+            return FString();
+        }
+
+        const FUTF8ToTCHAR Converted(
+                    reinterpret_cast<const ANSICHAR*>(
+                        Window.GetData() + WindowOffset),
+                    Length);
+        WindowOffset += Length;
+
+        return FString(Converted.Length(), Converted.Get());
+    }
+
+private:
+    /** Makes sure the next bytes are in the window, reading the next chunk of
+     *  the file if needed; fails past the end of the file. */
+    bool Ensure(const int32 Size)
+    {
+        if (bFailed)
+        {
+            return false;
+        }
+
+        if (WindowOffset + Size <= Window.Num())
+        {
+            return true;
+        }
+
+        if (GetOffset() + Size > FileSize)
+        {
+            bFailed = true;
+            return false;
+        }
+
+        /* Keeps the bytes not consumed yet and reads the next chunk after
+         * them. */
+        const int32 Unread = Window.Num() - WindowOffset;
+        Window.RemoveAt(0, WindowOffset, false);
+        WindowStart += WindowOffset;
+        WindowOffset = 0;
+
+        const int32 Chunk = static_cast<int32>(FMath::Min<int64>(
+                    FMath::Max(Size - Unread, READ_CHUNK_SIZE),
+                    FileSize - WindowStart - Unread));
+        Window.AddUninitialized(Chunk);
+
+        if (!File->Read(Window.GetData() + Unread, Chunk))
+        {
+            bFailed = true;
+            return false;
+        }
+
+        return true;
+    }
+};
+
+/** Writes the decoded lines as UTF-8 as they come. */
+class FTDecodedWriter
+{
+private:
+    TUniquePtr<FArchive> File;
+
+public:
+    explicit FTDecodedWriter(const FString& Path)
+        : File(IFileManager::Get().CreateFileWriter(*Path))
+    {
+        static const uint8 UTF8_BOM[] = { 0xEF, 0xBB, 0xBF };
+
+        if (File)
+        {
+            File->Serialize(const_cast<uint8*>(UTF8_BOM), sizeof(UTF8_BOM));
+        }
+    }
+
+    FORCEINLINE bool IsOpen() const
+    {
+        return File.IsValid();
+    }
+
+    void WriteLine(const FString& Line)
+    {
+        const FTCHARToUTF8 Utf8(*(Line + LINE_TERMINATOR));
+        File->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+    }
+
+    bool Close()
+    {
+        const bool bClosed = File->Close();
+        File.Reset();
+
+        return bClosed;
+    }
+};
+
+/** Quotes a CSV field. */
+static FString QuoteCsv(const FString& Field)
+{
+    return FString::Printf(TEXT("\"%s\""),
+                           *Field.Replace(TEXT("\""), TEXT("\"\"")));
+}
+
+/** Decodes the arguments of an entry; fails on an unknown argument type. */
+static bool DecodeArguments(FTLogBinaryReader& Reader, const int64 End,
+                            const TMap<uint32, FString>& Names,
+                            TArray<FString>& Out_Arguments)
+{
+    while (!Reader.HasFailed() && Reader.GetOffset() < End)
+    {
+        switch (static_cast<FTLogBinary::EArgument>(Reader.Read<uint8>()))
+        {
+        case FTLogBinary::EArgument::Bool:
+            Out_Arguments.Add(Reader.Read<uint8>() ? TEXT("True")
+                                                   : TEXT("False"));
+            break;
+
+        case FTLogBinary::EArgument::Int:
+            Out_Arguments.Add(FString::Printf(TEXT("%lld"),
+                                              Reader.Read<int64>()));
+            break;
+
+        case FTLogBinary::EArgument::UInt:
+            Out_Arguments.Add(FString::Printf(TEXT("%llu"),
+                                              Reader.Read<uint64>()));
+            break;
+
+        case FTLogBinary::EArgument::Float:
+            Out_Arguments.Add(FString::SanitizeFloat(
+                                  static_cast<double>(Reader.Read<float>()), 1));
+            break;
+
+        case FTLogBinary::EArgument::Double:
+            Out_Arguments.Add(FString::Printf(TEXT("%f"),
+                                              Reader.Read<double>()));
+            break;
+
+        case FTLogBinary::EArgument::Vector:
+            Out_Arguments.Add(Reader.Read<FVector>().ToString());
+            break;
+
+        case FTLogBinary::EArgument::Rotator:
+            Out_Arguments.Add(Reader.Read<FRotator>().ToString());
+            break;
+
+        case FTLogBinary::EArgument::Name:
+        {
+            const FString* Name = Names.Find(Reader.Read<uint32>());
+            Out_Arguments.Add(Name ? *Name : FString(TEXT("?")));
+        }
+            break;
+
+        case FTLogBinary::EArgument::Actor:
+        {
+            const uint32 UniqueId = Reader.Read<uint32>();
+            const FString* Name = Names.Find(Reader.Read<uint32>());
+            Out_Arguments.Add(FString::Printf(TEXT("%s#%u"),
+                                              Name ? **Name : TEXT("?"),
+                                              UniqueId));
+        }
+            break;
+
+        case FTLogBinary::EArgument::AnsiString:
+        case FTLogBinary::EArgument::String:
+            Out_Arguments.Add(Reader.ReadString());
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return !Reader.HasFailed() && Reader.GetOffset() == End;
+}
+
+UTLogDecodeCommandlet::UTLogDecodeCommandlet(
+        const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UTLogDecodeCommandlet::Main(const FString& Params)
+{
+    FString Input;
+    if (!FParse::Value(*Params, TEXT("Input="), Input))
+    {
+        TArray<FString> Files;
+        IFileManager::Get().FindFiles(
+                    Files, *(FPaths::ProjectLogDir()
+                             / (FString(TEXT("*")) + FTLogBinary::EXTENSION)),
+                    true, false);
+
+        /* The time stamps in the file names sort chronologically. */
+        Files.Sort();
+
+        if (Files.Num() == 0)
+        {
+            UE_LOG(Log_Generic, Error,
+                   TEXT("[ERROR TLogDecode] no binary log found under '%s'!"),
+                   *FPaths::ProjectLogDir());
+            return 1;
+        }
+
+        Input = FPaths::ProjectLogDir() / Files.Last();
+    }
+
+    FString Format(TEXT("Text"));
+    FParse::Value(*Params, TEXT("Format="), Format);
+    const bool bCsv = Format.Equals(TEXT("CSV"), ESearchCase::IgnoreCase);
+
+    FString Output;
+    if (!FParse::Value(*Params, TEXT("Output="), Output))
+    {
+        Output = FPaths::ChangeExtension(Input, bCsv ? TEXT(".csv")
+                                                     : TEXT(".txt"));
+    }
+
+    FTLogBinaryReader Reader(
+                FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Input));
+    if (Reader.HasFailed())
+    {
+        UE_LOG(Log_Generic, Error,
+               TEXT("[ERROR TLogDecode] cannot read '%s'!"), *Input);
+        return 1;
+    }
+
+    const uint32 Magic = Reader.Read<uint32>();
+    const uint16 Version = Reader.Read<uint16>();
+    const double SecondsPerCycle = Reader.Read<double>();
+    const uint64 StartCycles = Reader.Read<uint64>();
+    const FDateTime StartTime(Reader.Read<int64>());
+
+    if (Reader.HasFailed() || Magic != FTLogBinary::MAGIC
+            || Version != FTLogBinary::VERSION)
+    {
+        UE_LOG(Log_Generic, Error,
+               TEXT("[ERROR TLogDecode] '%s' is not a binary log of version"
+                    " %u!"), *Input, FTLogBinary::VERSION);
+        return 1;
+    }
+
+    FTDecodedWriter Writer(Output);
+    if (!Writer.IsOpen())
+    {
+        UE_LOG(Log_Generic, Error,
+               TEXT("[ERROR TLogDecode] cannot write '%s'!"), *Output);
+        return 1;
+    }
+
+    TMap<uint32, FTDecodedSite> Sites;
+    TMap<uint32, FString> Names;
+    TArray<FString> Arguments;
+    int64 Entries = 0;
+
+    if (bCsv)
+    {
+        Writer.WriteLine(TEXT("Seconds,Verbosity,Category,Key,File,Line,"
+                              "Function,Arguments"));
+    }
+    else
+    {
+        Writer.WriteLine(FString::Printf(TEXT("Recorded at %s (UTC)"),
+                                         *StartTime.ToString()));
+    }
+
+    /* A recording cut short by a crash ends in a partial record; everything
+     * before it still gets decoded. */
+    bool bPartial = false;
+
+    while (!Reader.IsAtEnd() && !bPartial)
+    {
+        switch (static_cast<FTLogBinary::ERecord>(Reader.Read<uint8>()))
+        {
+        case FTLogBinary::ERecord::Site:
+        {
+            const uint32 SiteId = Reader.Read<uint32>();
+
+            FTDecodedSite Site;
+            Site.Verbosity = Reader.Read<uint8>();
+            Site.Category = Reader.Read<uint8>();
+            Site.Key = Reader.Read<uint64>();
+            Site.Line = Reader.Read<int32>();
+            Site.File = Reader.ReadString();
+            Site.Function = Reader.ReadString();
+
+            if (Reader.HasFailed())
+            {
+                bPartial = true;
+                break;
+            }
+
+            Site.Verbosity = FMath::Min(
+                        Site.Verbosity,
+                        static_cast<uint8>(TLogCore::EVerbosity::VeryVerbose));
+            Site.Category = FMath::Min(
+                        Site.Category,
+                        static_cast<uint8>(UE_ARRAY_COUNT(CATEGORY_NAMES) - 1));
+
+            Sites.Add(SiteId, MoveTemp(Site));
+        }
+            break;
+
+        case FTLogBinary::ERecord::Name:
+        {
+            const uint32 NameId = Reader.Read<uint32>();
+            FString Name(Reader.ReadString());
+
+            if (Reader.HasFailed())
+            {
+                bPartial = true;
+                break;
+            }
+
+            Names.Add(NameId, MoveTemp(Name));
+        }
+            break;
+
+        case FTLogBinary::ERecord::Entry:
+        {
+            const uint32 SiteId = Reader.Read<uint32>();
+            const uint64 Cycles = Reader.Read<uint64>();
+            const uint32 PayloadSize = Reader.Read<uint32>();
+            const int64 End = Reader.GetOffset() + PayloadSize;
+
+            if (Reader.HasFailed() || End > Reader.GetSize())
+            {
+                bPartial = true;
+                break;
+            }
+
+            const FTDecodedSite* Site = Sites.Find(SiteId);
+            Arguments.Reset();
+
+            if (!Site || !DecodeArguments(Reader, End, Names, Arguments))
+            {
+                UE_LOG(Log_Generic, Error,
+                       TEXT("[ERROR TLogDecode] corrupt entry at byte %lld!"),
+                       Reader.GetOffset());
+                return 1;
+            }
+
+            /* Signed, so an entry stamped before the recording started
+             * still lands close to zero instead of wrapping around. */
+            const int64 ElapsedCycles = static_cast<int64>(
+                        Cycles - StartCycles);
+            const double Seconds =
+                    static_cast<double>(ElapsedCycles) * SecondsPerCycle;
+            const TCHAR* Tag = TLogCore::GetTag(
+                        static_cast<TLogCore::EVerbosity>(Site->Verbosity));
+
+            if (bCsv)
+            {
+                FString Line(FString::Printf(
+                                 TEXT("%.6f,%s,%s,%llu,%s,%d,%s"),
+                                 Seconds, Tag,
+                                 CATEGORY_NAMES[Site->Category], Site->Key,
+                                 *QuoteCsv(Site->File), Site->Line,
+                                 *QuoteCsv(Site->Function)));
+
+                for (const FString& Argument : Arguments)
+                {
+                    Line += TEXT(",");
+                    Line += QuoteCsv(Argument);
+                }
+
+                Writer.WriteLine(Line);
+            }
+            else
+            {
+                Writer.WriteLine(FString::Printf(
+                              TEXT("%.6f [%s %s %s %d] %s"),
+                              Seconds, Tag,
+                              *Site->File, *Site->Function, Site->Line,
+                              *FString::Join(Arguments, TEXT(" • "))));
+            }
+
+            ++Entries;
+        }
+            break;
+
+        default:
+        {
+            UE_LOG(Log_Generic, Error,
+                   TEXT("[ERROR TLogDecode] unknown record at byte %lld!"),
+                   Reader.GetOffset());
+        }
+            return 1;
+        }
+    }
+
+    if (bPartial)
+    {
+        UE_LOG(Log_Generic, Warning,
+               TEXT("[WARNING TLogDecode] '%s' ends in a partial record!"),
+               *Input);
+    }
+
+    if (!Writer.Close())
+    {
+        UE_LOG(Log_Generic, Error,
+               TEXT("[ERROR TLogDecode] cannot write '%s'!"), *Output);
+        return 1;
+    }
+
+    UE_LOG(Log_Generic, Display,
+           TEXT("[DISPLAY TLogDecode] decoded %lld entries into '%s'."),
+           Entries, *Output);
+
+    return 0;
+}
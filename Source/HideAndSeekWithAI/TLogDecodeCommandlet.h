@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <UObject/ObjectMacros.h>
+
+#include "TLogDecodeCommandlet.generated.h"
+
+/** Decodes a binary TLog file into text or CSV.
+ *
+ *  Usage:
+ *    -run=TLogDecode [-Input=<file.tlog>] [-Output=<file>] [-Format=Text|CSV]
+ *
+ *  Without an input the most recent binary log under Saved/Logs gets decoded;
+ *  without an output the decoded file is written next to the input. The text
+ *  format matches the regular TLog lines prefixed by the seconds since the
+ *  recording started; the CSV format has one column per argument. */
+UCLASS()
+class HIDEANDSEEKWITHAI_API UTLogDecodeCommandlet : public UCommandlet
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    virtual int32 Main(const FString& Params) override;
+};
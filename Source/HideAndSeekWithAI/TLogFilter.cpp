@@ -0,0 +1,415 @@
+#include "TLogFilter.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Containers/Map.h>
+#include <Containers/UnrealString.h>
+#include <HAL/CriticalSection.h>
+#include <HAL/IConsoleManager.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/ScopeLock.h>
+
+#include "TLog.h"
+#include "TLogWriter.h"
+
+/** The number of keys the rate limits are able to track; a power of two. */
+static constexpr uint32 BUCKETS = 1024;
+
+/** The number of counter shards; the threads take them in turns. */
+static constexpr uint32 COUNTER_SHARDS = 64;
+
+static_assert((BUCKETS & (BUCKETS - 1)) == 0,
+              "Error: the number of log buckets must be a power of two!");
+
+/** The category names, in the order of TLogCore::ECategory. */
+static const TCHAR* const CATEGORY_NAMES[FTLogFilter::CATEGORIES] = {
+    TEXT("AI"),
+    TEXT("Generic"),
+    TEXT("Input"),
+    TEXT("Player")
+};
+
+/** The verbosity names, in the order of TLogCore::EVerbosity. */
+static const TCHAR* const VERBOSITY_NAMES[FTLogFilter::MAX_VERBOSITY + 1] = {
+    TEXT("Fatal"),
+    TEXT("Error"),
+    TEXT("Warning"),
+    TEXT("Display"),
+    TEXT("Log"),
+    TEXT("Verbose"),
+    TEXT("VeryVerbose")
+};
+
+/** A token bucket, implemented as a generic cell rate algorithm: an entry
+ *  passes as long as its theoretical arrival time is not further ahead of now
+ *  than the burst allows. */
+struct FTLogBucket
+{
+    /** The log key; zero while the bucket is free. */
+    std::atomic<uint64> Key;
+
+    /** Cycles between two entries; zero means unlimited. */
+    std::atomic<uint64> Interval;
+
+    /** Cycles the arrival time may run ahead of now. */
+    std::atomic<uint64> Tolerance;
+
+    /** The theoretical arrival time of the next entry, in cycles. */
+    std::atomic<uint64> Arrival;
+
+    /** The number of entries the bucket has dropped. */
+    std::atomic<uint64> Suppressed;
+};
+
+/** A rate limit as configured. */
+struct FTLogRate
+{
+    double PerSecond;
+    int32 Burst;
+};
+
+std::atomic<uint8> FTLogFilter::MaxVerbosities[FTLogFilter::CATEGORIES] = {
+    { FTLogFilter::MAX_VERBOSITY },
+    { FTLogFilter::MAX_VERBOSITY },
+    { FTLogFilter::MAX_VERBOSITY },
+    { FTLogFilter::MAX_VERBOSITY }
+};
+std::atomic<bool> FTLogFilter::bRateLimiting(false);
+
+/** The buckets get claimed under the rates lock the first time a key gets
+ *  logged and are never released; looking them up is lock-free. */
+static FTLogBucket Buckets[BUCKETS];
+
+/** The counters of the threads sharing a shard, on a cache line of their
+ *  own. */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FTLogCounterShard
+{
+    std::atomic<uint64> FilteredEntries;
+    std::atomic<uint64> RateLimitedEntries;
+};
+
+static FTLogCounterShard CounterShards[COUNTER_SHARDS];
+static std::atomic<uint32> NextCounterShard(0);
+static thread_local FTLogCounterShard* ThreadCounterShard = nullptr;
+
+/** Guards the configured rates; only the console variables and the first
+ *  entry of each key take the lock. */
+static FCriticalSection RatesLock;
+static TMap<uint64, FTLogRate> KeyRates;
+static FTLogRate DefaultRate { 0.0, 1 };
+
+static FString VerbosityFilter;
+static FString RateLimits;
+static float DefaultRateLimit = 0.0f;
+
+/** Returns the counter shard of the calling thread. */
+static FTLogCounterShard& GetCounterShard()
+{
+    if (!ThreadCounterShard)
+    {
+        ThreadCounterShard = &CounterShards[
+                NextCounterShard.fetch_add(1, std::memory_order_relaxed)
+                % COUNTER_SHARDS];
+    }
+
+    return *ThreadCounterShard;
+}
+
+/** Sets the rate of a bucket out of the configured rates; the lock has to be
+ *  held. */
+static void ApplyRate(FTLogBucket& Bucket, const uint64 Key)
+{
+    const FTLogRate* Rate = KeyRates.Find(Key);
+    if (!Rate)
+    {
+        Rate = &DefaultRate;
+    }
+
+    uint64 Interval = 0;
+    if (Rate->PerSecond > 0.0)
+    {
+        Interval = static_cast<uint64>(
+                    1.0 / (Rate->PerSecond * FPlatformTime::GetSecondsPerCycle64()));
+        Interval = FMath::Max<uint64>(Interval, 1);
+    }
+
+    Bucket.Tolerance.store(Interval * static_cast<uint64>(
+                               FMath::Max(Rate->Burst - 1, 0)),
+                           std::memory_order_relaxed);
+    Bucket.Interval.store(Interval, std::memory_order_relaxed);
+}
+
+/** Parses the 't.Log.Verbosity' console variable. */
+static void OnVerbosityFilterChanged(IConsoleVariable* Variable)
+{
+    (void)Variable;
+
+    uint8 MaxVerbosities[FTLogFilter::CATEGORIES];
+    FMemory::Memset(MaxVerbosities, FTLogFilter::MAX_VERBOSITY);
+
+    TArray<FString> Entries;
+    VerbosityFilter.ParseIntoArrayWS(Entries, TEXT(","));
+
+    for (const FString& Entry : Entries)
+    {
+        FString CategoryName;
+        FString VerbosityName;
+        if (!Entry.Split(TEXT("="), &CategoryName, &VerbosityName))
+        {
+            TLOG_ERROR(TLOG_KEY_INFINITE, "Invalid t.Log.Verbosity entry!",
+                       Entry);
+            continue;
+        }
+
+        int32 Category = INDEX_NONE;
+        for (int32 Index = 0; Index < FTLogFilter::CATEGORIES; ++Index)
+        {
+            if (CategoryName.Equals(CATEGORY_NAMES[Index],
+                                    ESearchCase::IgnoreCase))
+            {
+                Category = Index;
+            }
+        }
+
+        int32 Verbosity = INDEX_NONE;
+        for (int32 Index = 0; Index <= FTLogFilter::MAX_VERBOSITY; ++Index)
+        {
+            if (VerbosityName.Equals(VERBOSITY_NAMES[Index],
+                                     ESearchCase::IgnoreCase))
+            {
+                Verbosity = Index;
+            }
+        }
+
+        if (Category == INDEX_NONE || Verbosity == INDEX_NONE)
+        {
+            TLOG_ERROR(TLOG_KEY_INFINITE,
+                       "Unknown category or verbosity in t.Log.Verbosity!",
+                       Entry);
+            continue;
+        }
+
+        MaxVerbosities[Category] = static_cast<uint8>(Verbosity);
+    }
+
+    FTLogFilter::SetMaxVerbosities(MaxVerbosities);
+}
+
+/** Parses the 't.Log.RateLimit' and 't.Log.DefaultRateLimit' console
+ *  variables. */
+static void OnRateLimitsChanged(IConsoleVariable* Variable)
+{
+    (void)Variable;
+
+    TMap<uint64, FTLogRate> NewKeyRates;
+
+    TArray<FString> Entries;
+    RateLimits.ParseIntoArrayWS(Entries, TEXT(","));
+
+    for (const FString& Entry : Entries)
+    {
+        FString Key;
+        FString Rate;
+        if (!Entry.Split(TEXT("="), &Key, &Rate) || !Key.IsNumeric())
+        {
+            TLOG_ERROR(TLOG_KEY_INFINITE, "Invalid t.Log.RateLimit entry!",
+                       Entry);
+            continue;
+        }
+
+        FString PerSecond(Rate);
+        FString Burst;
+        Rate.Split(TEXT(":"), &PerSecond, &Burst);
+
+        NewKeyRates.Add(FCString::Strtoui64(*Key, nullptr, 10),
+                        FTLogRate { FCString::Atod(*PerSecond),
+                                    Burst.IsEmpty() ? 1 : FCString::Atoi(*Burst) });
+    }
+
+    FScopeLock Lock(&RatesLock);
+
+    KeyRates = MoveTemp(NewKeyRates);
+    DefaultRate = FTLogRate { FMath::Max(DefaultRateLimit, 0.0f), 1 };
+
+    for (FTLogBucket& Bucket : Buckets)
+    {
+        const uint64 Key = Bucket.Key.load(std::memory_order_acquire);
+        if (Key != 0)
+        {
+            ApplyRate(Bucket, Key);
+        }
+    }
+
+    FTLogFilter::SetRateLimiting(KeyRates.Num() > 0
+                                 || DefaultRate.PerSecond > 0.0);
+}
+
+/** Prints the filter counters. */
+static void PrintStats()
+{
+    UE_LOG(Log_Generic, Display,
+           TEXT("[DISPLAY TLog] filtered: %llu, rate limited: %llu,"
+                " dropped by the writer: %llu"),
+           FTLogFilter::GetFilteredEntries(),
+           FTLogFilter::GetRateLimitedEntries(),
+           FTLogWriter::GetDroppedEntries());
+
+    for (const FTLogBucket& Bucket : Buckets)
+    {
+        const uint64 Suppressed = Bucket.Suppressed.load(std::memory_order_relaxed);
+        if (Suppressed > 0)
+        {
+            UE_LOG(Log_Generic, Display,
+                   TEXT("[DISPLAY TLog]   key %llu: %llu rate limited"),
+                   Bucket.Key.load(std::memory_order_relaxed), Suppressed);
+        }
+    }
+}
+
+static FAutoConsoleVariableRef CVarLogVerbosity(
+        TEXT("t.Log.Verbosity"),
+        VerbosityFilter,
+        TEXT("Caps the verbosity of log categories, e.g. \"AI=Warning"
+             " Generic=Log\".\n"
+             " Categories: AI, Generic, Input, Player\n"
+             " Verbosities: Fatal, Error, Warning, Display, Log, Verbose,"
+             " VeryVerbose"),
+        FConsoleVariableDelegate::CreateStatic(&OnVerbosityFilterChanged),
+        ECVF_Default);
+
+static FAutoConsoleVariableRef CVarLogRateLimit(
+        TEXT("t.Log.RateLimit"),
+        RateLimits,
+        TEXT("Rate limits log keys, e.g. \"406=2:5 4001=10\"; each entry is"
+             " <key>=<entries per second>[:<burst>]."),
+        FConsoleVariableDelegate::CreateStatic(&OnRateLimitsChanged),
+        ECVF_Default);
+
+static FAutoConsoleVariableRef CVarLogDefaultRateLimit(
+        TEXT("t.Log.DefaultRateLimit"),
+        DefaultRateLimit,
+        TEXT("Entries per second allowed for the log keys not listed in"
+             " t.Log.RateLimit; 0 means unlimited."),
+        FConsoleVariableDelegate::CreateStatic(&OnRateLimitsChanged),
+        ECVF_Default);
+
+static FAutoConsoleCommand CmdLogStats(
+        TEXT("t.Log.Stats"),
+        TEXT("Prints the number of filtered, rate limited and dropped log"
+             " entries."),
+        FConsoleCommandDelegate::CreateStatic(&PrintStats));
+
+uint64 FTLogFilter::GetFilteredEntries()
+{
+    uint64 Entries = 0;
+    for (const FTLogCounterShard& Shard : CounterShards)
+    {
+        Entries += Shard.FilteredEntries.load(std::memory_order_relaxed);
+    }
+
+    return Entries;
+}
+
+uint64 FTLogFilter::GetRateLimitedEntries()
+{
+    uint64 Entries = 0;
+    for (const FTLogCounterShard& Shard : CounterShards)
+    {
+        Entries += Shard.RateLimitedEntries.load(std::memory_order_relaxed);
+    }
+
+    return Entries;
+}
+
+void FTLogFilter::SetMaxVerbosities(const uint8 (&InMaxVerbosities)[CATEGORIES])
+{
+    for (uint8 Category = 0; Category < CATEGORIES; ++Category)
+    {
+        MaxVerbosities[Category].store(InMaxVerbosities[Category],
+                                       std::memory_order_relaxed);
+    }
+}
+
+void FTLogFilter::SetRateLimiting(const bool bInRateLimiting)
+{
+    bRateLimiting.store(bInRateLimiting, std::memory_order_relaxed);
+}
+
+void FTLogFilter::CountFiltered()
+{
+    GetCounterShard().FilteredEntries.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FTLogFilter::PassesRateLimit(const uint64 Key)
+{
+    if (Key == TLOG_KEY_INFINITE || Key == 0)
+    {
+        return true;
+    }
+
+    /* Finds the bucket of the key by linear probing; claims a free one the
+     * first time the key gets logged. The rate gets applied before the key is
+     * published, so no entry ever sees the bucket unthrottled. */
+    uint32 Index = static_cast<uint32>(
+                (Key * 0x9E3779B97F4A7C15ull) >> 32) & (BUCKETS - 1);
+    FTLogBucket* Bucket = nullptr;
+
+    for (uint32 Probe = 0; Probe < BUCKETS; ++Probe)
+    {
+        FTLogBucket& Candidate = Buckets[(Index + Probe) & (BUCKETS - 1)];
+        uint64 CandidateKey = Candidate.Key.load(std::memory_order_acquire);
+
+        if (CandidateKey == 0)
+        {
+            FScopeLock Lock(&RatesLock);
+
+            CandidateKey = Candidate.Key.load(std::memory_order_relaxed);
+            if (CandidateKey == 0)
+            {
+                ApplyRate(Candidate, Key);
+                Candidate.Key.store(Key, std::memory_order_release);
+                Bucket = &Candidate;
+                break;
+            }
+        }
+
+        if (CandidateKey == Key)
+        {
+            Bucket = &Candidate;
+            break;
+        }
+    }
+
+    /* Once all the buckets are taken, the rest of the keys go unlimited. */
+    if (!Bucket)
+    {
+        return true;
+    }
+
+    const uint64 Interval = Bucket->Interval.load(std::memory_order_relaxed);
+    if (Interval == 0)
+    {
+        return true;
+    }
+
+    const uint64 Tolerance = Bucket->Tolerance.load(std::memory_order_relaxed);
+    const uint64 Now = FPlatformTime::Cycles64();
+    uint64 Arrival = Bucket->Arrival.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const uint64 Start = FMath::Max(Arrival, Now);
+        if (Start - Now > Tolerance)
+        {
+            Bucket->Suppressed.fetch_add(1, std::memory_order_relaxed);
+            GetCounterShard().RateLimitedEntries.fetch_add(
+                        1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (Bucket->Arrival.compare_exchange_weak(
+                    Arrival, Start + Interval, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+}
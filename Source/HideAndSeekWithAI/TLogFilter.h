@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+
+#include <CoreTypes.h>
+
+/** The runtime filter every TLog entry passes before anything gets
+ *  constructed or formatted. It holds a maximum verbosity per category and a
+ *  token bucket per log key, both controlled by console variables:
+ *
+ *    t.Log.Verbosity "AI=Warning Generic=Log"
+ *        Caps the verbosity of the listed categories; the rest keep whatever
+ *        the engine's log categories allow.
+ *    t.Log.RateLimit "406=2:5 4001=10"
+ *        Lets through at most <rate> entries per second with bursts of up to
+ *        <burst> entries (one by default) for each listed key.
+ *    t.Log.DefaultRateLimit 0
+ *        The rate applied to the keys not listed above; 0 means unlimited.
+ *
+ *  Entries without a key (TLOG_KEY_INFINITE) are never rate limited. Filtered
+ *  and rate limited entries are counted, each thread into a counter on a cache
+ *  line of its own; 't.Log.Stats' prints the totals.
+ *
+ *  The verbosity and category arguments are the underlying values of
+ *  TLogCore::EVerbosity and TLogCore::ECategory. */
+struct HIDEANDSEEKWITHAI_API FTLogFilter
+{
+public:
+    /** The number of log categories. */
+    static constexpr uint8 CATEGORIES = 4;
+
+    /** The maximum verbosity; lets everything through. */
+    static constexpr uint8 MAX_VERBOSITY = 6;
+
+private:
+    /** The maximum verbosity of each category. */
+    static std::atomic<uint8> MaxVerbosities[CATEGORIES];
+
+    /** Whether any rate limit is set or not. */
+    static std::atomic<bool> bRateLimiting;
+
+public:
+    /** Determines whether an entry passes the filter or not. Without any rate
+     *  limit set, this is two relaxed loads and compares; a filtered entry
+     *  also bumps the calling thread's own counter. */
+    static FORCEINLINE bool Passes(const uint8 Verbosity, const uint8 Category,
+                                   const uint64 Key)
+    {
+        if (Verbosity > MaxVerbosities[Category].load(std::memory_order_relaxed))
+        {
+            CountFiltered();
+            return false;
+        }
+
+        return !bRateLimiting.load(std::memory_order_relaxed)
+                || PassesRateLimit(Key);
+    }
+
+    /** Returns the number of entries filtered out by their category
+     *  verbosity. */
+    static uint64 GetFilteredEntries();
+
+    /** Returns the number of entries dropped by the rate limits. */
+    static uint64 GetRateLimitedEntries();
+
+    /** Sets the maximum verbosity of all the categories at once; gets called
+     *  by the 't.Log.Verbosity' console variable. */
+    static void SetMaxVerbosities(const uint8 (&InMaxVerbosities)[CATEGORIES]);
+
+    /** Turns the rate limits on or off; gets called by the rate limit console
+     *  variables. */
+    static void SetRateLimiting(const bool bInRateLimiting);
+
+private:
+    /** Counts an entry filtered out by its category verbosity. */
+    static void CountFiltered();
+
+    /** Takes a token out of the bucket of a key. */
+    static bool PassesRateLimit(const uint64 Key);
+};
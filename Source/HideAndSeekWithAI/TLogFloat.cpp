@@ -0,0 +1,438 @@
+#include "TLogFloat.h"
+#include "HideAndSeekWithAI.h"
+
+#include <cstring>
+
+/** The range of binary exponents the scaled values end up in; the digit
+ *  generation relies on it. */
+static constexpr int32 ALPHA = -60;
+static constexpr int32 GAMMA = -32;
+
+/** The smallest decimal exponent and the step of the cached powers. */
+static constexpr int32 CACHED_POWERS_MIN_EXPONENT = -300;
+static constexpr int32 CACHED_POWERS_STEP = 8;
+
+/** Plain notation is used for the decimal exponents in this range. */
+static constexpr int32 MIN_PLAIN_EXPONENT = -4;
+static constexpr int32 MAX_PLAIN_EXPONENT = 14;
+
+/** A floating point number with a 64-bit significand, F * 2^E. */
+struct FTDiyFp
+{
+    uint64 F;
+    int32 E;
+};
+
+/** A power of ten, F * 2^E ~= 10^K. */
+struct FTCachedPower
+{
+    uint64 F;
+    int32 E;
+    int32 K;
+};
+
+/** The normalized powers of ten from 10^-300 to 10^324 in steps of eight,
+ *  rounded to nearest. */
+static constexpr FTCachedPower CACHED_POWERS[] = {
+    { 0xAB70FE17C79AC6CAull, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4Full, -1034, -292 },
+    { 0xBE5691EF416BD60Cull, -1007, -284 },
+    { 0x8DD01FAD907FFC3Cull,  -980, -276 },
+    { 0xD3515C2831559A83ull,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ull,  -927, -260 },
+    { 0xEA9C227723EE8BCBull,  -901, -252 },
+    { 0xAECC49914078536Dull,  -874, -244 },
+    { 0x823C12795DB6CE57ull,  -847, -236 },
+    { 0xC21094364DFB5637ull,  -821, -228 },
+    { 0x9096EA6F3848984Full,  -794, -220 },
+    { 0xD77485CB25823AC7ull,  -768, -212 },
+    { 0xA086CFCD97BF97F4ull,  -741, -204 },
+    { 0xEF340A98172AACE5ull,  -715, -196 },
+    { 0xB23867FB2A35B28Eull,  -688, -188 },
+    { 0x84C8D4DFD2C63F3Bull,  -661, -180 },
+    { 0xC5DD44271AD3CDBAull,  -635, -172 },
+    { 0x936B9FCEBB25C996ull,  -608, -164 },
+    { 0xDBAC6C247D62A584ull,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ull,  -555, -148 },
+    { 0xF3E2F893DEC3F126ull,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ull,  -502, -132 },
+    { 0x87625F056C7C4A8Bull,  -475, -124 },
+    { 0xC9BCFF6034C13053ull,  -449, -116 },
+    { 0x964E858C91BA2655ull,  -422, -108 },
+    { 0xDFF9772470297EBDull,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88Full,  -369,  -92 },
+    { 0xF8A95FCF88747D94ull,  -343,  -84 },
+    { 0xB94470938FA89BCFull,  -316,  -76 },
+    { 0x8A08F0F8BF0F156Bull,  -289,  -68 },
+    { 0xCDB02555653131B6ull,  -263,  -60 },
+    { 0x993FE2C6D07B7FACull,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ull,  -210,  -44 },
+    { 0xAA242499697392D3ull,  -183,  -36 },
+    { 0xFD87B5F28300CA0Eull,  -157,  -28 },
+    { 0xBCE5086492111AEBull,  -130,  -20 },
+    { 0x8CBCCC096F5088CCull,  -103,  -12 },
+    { 0xD1B71758E219652Cull,   -77,   -4 },
+    { 0x9C40000000000000ull,   -50,    4 },
+    { 0xE8D4A51000000000ull,   -24,   12 },
+    { 0xAD78EBC5AC620000ull,     3,   20 },
+    { 0x813F3978F8940984ull,    30,   28 },
+    { 0xC097CE7BC90715B3ull,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ull,    83,   44 },
+    { 0xD5D238A4ABE98068ull,   109,   52 },
+    { 0x9F4F2726179A2245ull,   136,   60 },
+    { 0xED63A231D4C4FB27ull,   162,   68 },
+    { 0xB0DE65388CC8ADA8ull,   189,   76 },
+    { 0x83C7088E1AAB65DBull,   216,   84 },
+    { 0xC45D1DF942711D9Aull,   242,   92 },
+    { 0x924D692CA61BE758ull,   269,  100 },
+    { 0xDA01EE641A708DEAull,   295,  108 },
+    { 0xA26DA3999AEF774Aull,   322,  116 },
+    { 0xF209787BB47D6B85ull,   348,  124 },
+    { 0xB454E4A179DD1877ull,   375,  132 },
+    { 0x865B86925B9BC5C2ull,   402,  140 },
+    { 0xC83553C5C8965D3Dull,   428,  148 },
+    { 0x952AB45CFA97A0B3ull,   455,  156 },
+    { 0xDE469FBD99A05FE3ull,   481,  164 },
+    { 0xA59BC234DB398C25ull,   508,  172 },
+    { 0xF6C69A72A3989F5Cull,   534,  180 },
+    { 0xB7DCBF5354E9BECEull,   561,  188 },
+    { 0x88FCF317F22241E2ull,   588,  196 },
+    { 0xCC20CE9BD35C78A5ull,   614,  204 },
+    { 0x98165AF37B2153DFull,   641,  212 },
+    { 0xE2A0B5DC971F303Aull,   667,  220 },
+    { 0xA8D9D1535CE3B396ull,   694,  228 },
+    { 0xFB9B7CD9A4A7443Cull,   720,  236 },
+    { 0xBB764C4CA7A44410ull,   747,  244 },
+    { 0x8BAB8EEFB6409C1Aull,   774,  252 },
+    { 0xD01FEF10A657842Cull,   800,  260 },
+    { 0x9B10A4E5E9913129ull,   827,  268 },
+    { 0xE7109BFBA19C0C9Dull,   853,  276 },
+    { 0xAC2820D9623BF429ull,   880,  284 },
+    { 0x80444B5E7AA7CF85ull,   907,  292 },
+    { 0xBF21E44003ACDD2Dull,   933,  300 },
+    { 0x8E679C2F5E44FF8Full,   960,  308 },
+    { 0xD433179D9C8CB841ull,   986,  316 },
+    { 0x9E19DB92B4E31BA9ull,  1013,  324 }
+};
+
+/** The value with its lower and upper rounding boundaries, all normalized to
+ *  the same exponent. */
+struct FTBoundaries
+{
+    FTDiyFp Value;
+    FTDiyFp Minus;
+    FTDiyFp Plus;
+};
+
+static FORCEINLINE FTDiyFp Subtract(const FTDiyFp& X, const FTDiyFp& Y)
+{
+    return { X.F - Y.F, X.E };
+}
+
+/** Returns the upper half of the 128-bit product, rounded. */
+static FORCEINLINE FTDiyFp Multiply(const FTDiyFp& X, const FTDiyFp& Y)
+{
+    const uint64 XLow = X.F & 0xFFFFFFFFu;
+    const uint64 XHigh = X.F >> 32;
+    const uint64 YLow = Y.F & 0xFFFFFFFFu;
+    const uint64 YHigh = Y.F >> 32;
+
+    const uint64 LowLow = XLow * YLow;
+    const uint64 LowHigh = XLow * YHigh;
+    const uint64 HighLow = XHigh * YLow;
+    const uint64 HighHigh = XHigh * YHigh;
+
+    const uint64 Middle = (LowLow >> 32) + (LowHigh & 0xFFFFFFFFu)
+            + (HighLow & 0xFFFFFFFFu) + (uint64(1) << 31);
+
+    return { HighHigh + (LowHigh >> 32) + (HighLow >> 32) + (Middle >> 32),
+             X.E + Y.E + 64 };
+}
+
+static FORCEINLINE FTDiyFp Normalize(FTDiyFp X)
+{
+    while ((X.F >> 63) == 0)
+    {
+        X.F <<= 1;
+        --X.E;
+    }
+
+    return X;
+}
+
+/** Computes the boundaries of a positive value with a significand of
+ *  PRECISION bits, hidden bit included. */
+template<int32 PRECISION, int32 BIAS>
+static FTBoundaries ComputeBoundaries(const uint64 Bits)
+{
+    constexpr uint64 HIDDEN_BIT = uint64(1) << (PRECISION - 1);
+    constexpr int32 MIN_EXPONENT = 1 - BIAS;
+
+    const uint64 Exponent = Bits >> (PRECISION - 1);
+    const uint64 Fraction = Bits & (HIDDEN_BIT - 1);
+
+    const FTDiyFp Value = (Exponent == 0)
+            ? FTDiyFp{ Fraction, MIN_EXPONENT }
+            : FTDiyFp{ Fraction + HIDDEN_BIT,
+                       static_cast<int32>(Exponent) - BIAS };
+
+    /* The gap below is half as wide right above a power of two. */
+    const bool bLowerBoundaryIsCloser = (Fraction == 0 && Exponent > 1);
+
+    const FTDiyFp Plus{ 2 * Value.F + 1, Value.E - 1 };
+    const FTDiyFp Minus = bLowerBoundaryIsCloser
+            ? FTDiyFp{ 4 * Value.F - 1, Value.E - 2 }
+            : FTDiyFp{ 2 * Value.F - 1, Value.E - 1 };
+
+    const FTDiyFp NormalizedPlus = Normalize(Plus);
+    const FTDiyFp NormalizedMinus{
+        Minus.F << (Minus.E - NormalizedPlus.E), NormalizedPlus.E };
+
+    return { Normalize(Value), NormalizedMinus, NormalizedPlus };
+}
+
+/** Returns the cached power which scales a value of a binary exponent into
+ *  [ALPHA, GAMMA]. */
+static FORCEINLINE const FTCachedPower& GetCachedPower(const int32 E)
+{
+    /* 78913 / 2^18 approximates log10(2). */
+    const int32 F = ALPHA - E - 1;
+    const int32 K = (F * 78913) / (1 << 18) + (F > 0 ? 1 : 0);
+    const int32 Index = (-CACHED_POWERS_MIN_EXPONENT + K
+                         + (CACHED_POWERS_STEP - 1)) / CACHED_POWERS_STEP;
+
+    return CACHED_POWERS[Index];
+}
+
+/** Returns the number of decimal digits of a value and the power of ten of
+ *  its leading digit. */
+static FORCEINLINE int32 CountDigits(const uint32 Value, uint32& Out_Power)
+{
+    static constexpr uint32 POWERS[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+
+    int32 Digits = 10;
+    while (Digits > 1 && Value < POWERS[Digits - 1])
+    {
+        --Digits;
+    }
+
+    Out_Power = POWERS[Digits - 1];
+    return Digits;
+}
+
+/** Moves the last digit towards the value while the result stays inside the
+ *  rounding interval and gets closer. */
+static FORCEINLINE void Round(ANSICHAR* Digits, const int32 Length,
+                              const uint64 Distance, const uint64 Delta,
+                              uint64 Rest, const uint64 TenK)
+{
+    while (Rest < Distance && Delta - Rest >= TenK
+           && (Rest + TenK < Distance
+               || Distance - Rest > Rest + TenK - Distance))
+    {
+        --Digits[Length - 1];
+        Rest += TenK;
+    }
+}
+
+/** Generates the digits of W, somewhere between Minus and Plus; the value is
+ *  Digits * 10^Out_Exponent. */
+static int32 GenerateDigits(ANSICHAR* Out_Digits, int32& Out_Exponent,
+                            const FTDiyFp& Minus, const FTDiyFp& W,
+                            const FTDiyFp& Plus)
+{
+    uint64 Delta = Subtract(Plus, Minus).F;
+    uint64 Distance = Subtract(Plus, W).F;
+
+    const FTDiyFp One{ uint64(1) << -Plus.E, Plus.E };
+
+    uint32 Integral = static_cast<uint32>(Plus.F >> -One.E);
+    uint64 Fractional = Plus.F & (One.F - 1);
+
+    int32 Length = 0;
+    uint32 Power = 0;
+
+    for (int32 Remaining = CountDigits(Integral, Power); Remaining > 0; )
+    {
+        Out_Digits[Length++] = static_cast<ANSICHAR>('0' + Integral / Power);
+        Integral %= Power;
+        --Remaining;
+
+        const uint64 Rest = (static_cast<uint64>(Integral) << -One.E)
+                + Fractional;
+        if (Rest <= Delta)
+        {
+            Out_Exponent += Remaining;
+            Round(Out_Digits, Length, Distance, Delta, Rest,
+                  static_cast<uint64>(Power) << -One.E);
+            return Length;
+        }
+
+        Power /= 10;
+    }
+
+    int32 FractionalDigits = 0;
+    for (;;)
+    {
+        Fractional *= 10;
+        Out_Digits[Length++] = static_cast<ANSICHAR>('0' + (Fractional >> -One.E));
+        Fractional &= One.F - 1;
+        ++FractionalDigits;
+
+        Delta *= 10;
+        Distance *= 10;
+
+        if (Fractional <= Delta)
+        {
+            break;
+        }
+    }
+
+    Out_Exponent -= FractionalDigits;
+    Round(Out_Digits, Length, Distance, Delta, Fractional, One.F);
+
+    return Length;
+}
+
+/** Generates the shortest digits of a positive value. */
+static int32 Grisu2(ANSICHAR* Out_Digits, int32& Out_Exponent,
+                    const FTBoundaries& Boundaries)
+{
+    const FTCachedPower& Cached = GetCachedPower(Boundaries.Plus.E);
+    const FTDiyFp Scale{ Cached.F, Cached.E };
+
+    const FTDiyFp W = Multiply(Boundaries.Value, Scale);
+    const FTDiyFp Minus = Multiply(Boundaries.Minus, Scale);
+    const FTDiyFp Plus = Multiply(Boundaries.Plus, Scale);
+
+    /* The products are off by at most one unit; the interval shrinks by it
+     * to stay safe. */
+    Out_Exponent = -Cached.K;
+    return GenerateDigits(Out_Digits, Out_Exponent,
+                          FTDiyFp{ Minus.F + 1, Minus.E }, W,
+                          FTDiyFp{ Plus.F - 1, Plus.E });
+}
+
+/** Appends a decimal exponent of at least two digits, like printf does. */
+static int32 WriteExponent(ANSICHAR* Out_Buffer, int32 Exponent)
+{
+    int32 Length = 0;
+
+    Out_Buffer[Length++] = 'e';
+    Out_Buffer[Length++] = Exponent < 0 ? '-' : '+';
+    Exponent = Exponent < 0 ? -Exponent : Exponent;
+
+    if (Exponent >= 100)
+    {
+        Out_Buffer[Length++] = static_cast<ANSICHAR>('0' + Exponent / 100);
+        Exponent %= 100;
+    }
+
+    Out_Buffer[Length++] = static_cast<ANSICHAR>('0' + Exponent / 10);
+    Out_Buffer[Length++] = static_cast<ANSICHAR>('0' + Exponent % 10);
+
+    return Length;
+}
+
+int32 FTLogFloat::ToShortest(const double Value, const bool bSinglePrecision,
+                             ANSICHAR* Out_Buffer)
+{
+    uint64 Bits = 0;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    const bool bNegative = (Bits >> 63) != 0;
+    Bits &= ~(uint64(1) << 63);
+
+    int32 Length = 0;
+
+    if (Bits >= 0x7FF0000000000000ull)
+    {
+        const char* const Text = (Bits == 0x7FF0000000000000ull)
+                ? (bNegative ? "-inf" : "inf") : "nan";
+        Length = static_cast<int32>(std::strlen(Text));
+        std::memcpy(Out_Buffer, Text, Length);
+        return Length;
+    }
+
+    if (bNegative)
+    {
+        Out_Buffer[Length++] = '-';
+    }
+
+    if (Bits == 0)
+    {
+        std::memcpy(Out_Buffer + Length, "0.0", 3);
+        return Length + 3;
+    }
+
+    ANSICHAR Digits[20];
+    int32 Exponent = 0;
+    int32 DigitCount = 0;
+
+    if (bSinglePrecision)
+    {
+        const float Single = static_cast<float>(bNegative ? -Value : Value);
+        uint32 SingleBits = 0;
+        std::memcpy(&SingleBits, &Single, sizeof(SingleBits));
+
+        DigitCount = Grisu2(Digits, Exponent,
+                            ComputeBoundaries<24, 150>(SingleBits));
+    }
+    else
+    {
+        DigitCount = Grisu2(Digits, Exponent,
+                            ComputeBoundaries<53, 1075>(Bits));
+    }
+
+    /* The value is 0.Digits * 10^Point. */
+    const int32 Point = DigitCount + Exponent;
+
+    if (Point - 1 >= MIN_PLAIN_EXPONENT && Point - 1 <= MAX_PLAIN_EXPONENT)
+    {
+        if (Point <= 0)
+        {
+            /* 0.000Digits */
+            Out_Buffer[Length++] = '0';
+            Out_Buffer[Length++] = '.';
+            std::memset(Out_Buffer + Length, '0', -Point);
+            Length += -Point;
+            std::memcpy(Out_Buffer + Length, Digits, DigitCount);
+            Length += DigitCount;
+        }
+        else if (Point < DigitCount)
+        {
+            /* Dig.its */
+            std::memcpy(Out_Buffer + Length, Digits, Point);
+            Length += Point;
+            Out_Buffer[Length++] = '.';
+            std::memcpy(Out_Buffer + Length, Digits + Point, DigitCount - Point);
+            Length += DigitCount - Point;
+        }
+        else
+        {
+            /* Digits000.0 */
+            std::memcpy(Out_Buffer + Length, Digits, DigitCount);
+            Length += DigitCount;
+            std::memset(Out_Buffer + Length, '0', Point - DigitCount);
+            Length += Point - DigitCount;
+            Out_Buffer[Length++] = '.';
+            Out_Buffer[Length++] = '0';
+        }
+
+        return Length;
+    }
+
+    /* D.igitse+XX */
+    Out_Buffer[Length++] = Digits[0];
+    if (DigitCount > 1)
+    {
+        Out_Buffer[Length++] = '.';
+        std::memcpy(Out_Buffer + Length, Digits + 1, DigitCount - 1);
+        Length += DigitCount - 1;
+    }
+
+    return Length + WriteExponent(Out_Buffer + Length, Point - 1);
+}
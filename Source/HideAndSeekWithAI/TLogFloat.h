@@ -0,0 +1,25 @@
+#pragma once
+
+#include <CoreTypes.h>
+
+/** Shortest round-trip formatting of floating point values for TLog. The
+ *  digits come from Grisu2 (Loitsch, "Printing Floating-Point Numbers Quickly
+ *  and Accurately with Integers", 2010): a handful of 64-bit multiplications
+ *  against a cached power of ten, no printf, no parsing back. The output
+ *  always reads back as the very same value and is the shortest one for all
+ *  but a tiny fraction of the inputs, which get a digit more. */
+struct HIDEANDSEEKWITHAI_API FTLogFloat
+{
+public:
+    /** The longest text ToShortest writes. */
+    static constexpr int32 MAX_LENGTH = 32;
+
+public:
+    /** Writes the shortest text which reads back as the very same value into
+     *  a buffer of MAX_LENGTH characters and returns its length; no null
+     *  terminator gets written. Single precision values get the digits a
+     *  float needs. Exponents from -4 up to 14 come out in plain notation,
+     *  the rest like printf's "%e" with the trailing zeros dropped. */
+    static int32 ToShortest(const double Value, const bool bSinglePrecision,
+                            ANSICHAR* Out_Buffer);
+};
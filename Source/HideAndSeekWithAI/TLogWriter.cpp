@@ -0,0 +1,482 @@
+#include "TLogWriter.h"
+#include "HideAndSeekWithAI.h"
+
+#include <HAL/Event.h>
+#include <HAL/PlatformProcess.h>
+#include <HAL/PlatformTime.h>
+#include <HAL/RunnableThread.h>
+#include <Misc/ScopeLock.h>
+
+#include "TLog.h"
+
+/** Milliseconds the writer sleeps between two drains unless woken up. */
+static constexpr uint32 WRITER_INTERVAL_MS = 5;
+
+/** The writer gets woken up once this many entries wait in a ring. */
+static constexpr uint32 WAKE_THRESHOLD = FTLogWriter::CAPACITY / 4;
+
+static_assert((FTLogWriter::CAPACITY & (FTLogWriter::CAPACITY - 1)) == 0,
+              "Error: the log ring capacity must be a power of two!");
+
+std::atomic<FTLogWriter*> FTLogWriter::SInstance(nullptr);
+std::atomic<FTLogWriter::FThreadRing*> FTLogWriter::SRings[MAX_THREADS] = {};
+std::atomic<int32> FTLogWriter::SRingCount(0);
+std::atomic<uint64> FTLogWriter::SDroppedEntries(0);
+thread_local FTLogWriter::FThreadRingOwner FTLogWriter::SThreadRing;
+
+FTLogWriter::FThreadRing::FThreadRing()
+    : Slots(new FSlot[CAPACITY]),
+      Head(0),
+      Tail(0),
+      bPushing(false),
+      bOwned(true)
+{
+    for (uint32 Index = 0; Index < CAPACITY; ++Index)
+    {
+        Slots[Index].Site = nullptr;
+        Slots[Index].Cycles = 0;
+        Slots[Index].bBinary = false;
+    }
+}
+
+FTLogWriter::FThreadRingOwner::FThreadRingOwner()
+    : Ring(nullptr),
+      bWarned(false)
+{
+
+}
+
+FTLogWriter::FThreadRingOwner::~FThreadRingOwner()
+{
+    /* The entries left in the ring still get drained; the next owner just
+     * pushes after them. */
+    if (Ring)
+    {
+        Ring->bOwned.store(false, std::memory_order_release);
+    }
+}
+
+FTLogWriter::FOnScreenEntry::FOnScreenEntry(const TLogSite* InSite,
+                                            FString&& InEntry)
+    : Site(InSite),
+      Entry(MoveTemp(InEntry))
+{
+
+}
+
+FTLogWriter::FTLogWriter()
+    : ReportedDroppedEntries(SDroppedEntries.load(std::memory_order_relaxed)),
+      WakeEvent(FPlatformProcess::GetSynchEventFromPool(false)),
+      bStopping(false),
+      Thread(nullptr),
+      StartCycles(FPlatformTime::Cycles64()),
+      StartTime(FDateTime::UtcNow())
+{
+
+}
+
+FTLogWriter::~FTLogWriter()
+{
+    BinarySink.Reset();
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+}
+
+void FTLogWriter::Startup()
+{
+    if (SInstance.load() || !FPlatformProcess::SupportsMultithreading())
+    {
+        return;
+    }
+
+    FTLogWriter* Writer = new FTLogWriter();
+    Writer->Thread = FRunnableThread::Create(Writer, TEXT("TLogWriter"), 0,
+                                             TPri_BelowNormal);
+    if (!Writer->Thread)
+    {
+        delete Writer;
+        return;
+    }
+
+    SInstance.store(Writer);
+}
+
+void FTLogWriter::Shutdown()
+{
+    FTLogWriter* Writer = SInstance.exchange(nullptr);
+    if (!Writer)
+    {
+        return;
+    }
+
+    /* Every push starting from here on sees no writer; waits for the ones
+     * already in flight. All of it is sequentially consistent, so a ring
+     * that got flagged before the writer went away is seen here. */
+    const int32 RingsInUse = FMath::Min(SRingCount.load(), MAX_THREADS);
+    for (int32 Index = 0; Index < RingsInUse; ++Index)
+    {
+        const FThreadRing* Ring = SRings[Index].load();
+        while (Ring && Ring->bPushing.load())
+        {
+            FPlatformProcess::Yield();
+        }
+    }
+
+    /* Waits for the writer thread to drain the ring and quit. */
+    Writer->Thread->Kill(true);
+    delete Writer->Thread;
+
+    /* Anything pushed while the thread was quitting is written right here. */
+    Writer->Drain();
+
+    delete Writer;
+}
+
+bool FTLogWriter::Push(const TLogSite& Site, const uint64 Cycles,
+                       const TCHAR* Entry, const int32 Length)
+{
+    if (!IsRunning())
+    {
+        return false;
+    }
+
+    FThreadRing* Ring = GetThreadRing();
+    if (!Ring)
+    {
+        return false;
+    }
+
+    FTLogWriter* Writer = BeginPush(*Ring);
+    if (!Writer)
+    {
+        return false;
+    }
+
+    bool bPushed = true;
+
+    if (FSlot* Slot = Claim(*Ring))
+    {
+        Slot->Site = &Site;
+        Slot->Cycles = Cycles;
+        Slot->Text.Reset();
+        Slot->Text.Append(Entry, Length + 1);
+        Slot->bBinary = false;
+        Writer->Publish(*Ring);
+    }
+    else
+    {
+        SDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+        Writer->WakeEvent->Trigger();
+
+        /* Errors are never dropped; they get written synchronously
+         * instead. */
+        bPushed = (Site.Verbosity != TLogCore::EVerbosity::Error);
+    }
+
+    EndPush(*Ring);
+
+    return bPushed;
+}
+
+void FTLogWriter::PushBinary(const TLogSite& Site, const uint64 Cycles,
+                             const FTLogPayload& Payload)
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    FThreadRing* Ring = GetThreadRing();
+    if (!Ring)
+    {
+        SDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    FTLogWriter* Writer = BeginPush(*Ring);
+    if (!Writer)
+    {
+        return;
+    }
+
+    if (FSlot* Slot = Claim(*Ring))
+    {
+        Slot->Site = &Site;
+        Slot->Cycles = Cycles;
+        Slot->bBinary = true;
+        Slot->Payload.Reset();
+        Slot->Payload.Append(Payload);
+        Writer->Publish(*Ring);
+    }
+    else
+    {
+        SDroppedEntries.fetch_add(1, std::memory_order_relaxed);
+        Writer->WakeEvent->Trigger();
+    }
+
+    EndPush(*Ring);
+}
+
+bool FTLogWriter::IsRunning()
+{
+    return SInstance.load(std::memory_order_relaxed) != nullptr;
+}
+
+void FTLogWriter::FlushOnScreen()
+{
+    check(IsInGameThread());
+
+    FTLogWriter* Writer = SInstance.load(std::memory_order_acquire);
+    if (!Writer)
+    {
+        return;
+    }
+
+    TArray<FOnScreenEntry> OnScreenEntries;
+    {
+        FScopeLock Lock(&Writer->OnScreenLock);
+        if (Writer->PendingOnScreenEntries.Num() == 0)
+        {
+            return;
+        }
+
+        Swap(OnScreenEntries, Writer->PendingOnScreenEntries);
+    }
+
+    for (const FOnScreenEntry& OnScreenEntry : OnScreenEntries)
+    {
+        TLogCore::WriteOnScreen(*OnScreenEntry.Site, *OnScreenEntry.Entry);
+    }
+}
+
+uint64 FTLogWriter::GetDroppedEntries()
+{
+    return SDroppedEntries.load(std::memory_order_relaxed);
+}
+
+uint32 FTLogWriter::Run()
+{
+    while (!bStopping.load(std::memory_order_relaxed))
+    {
+        Drain();
+        WakeEvent->Wait(WRITER_INTERVAL_MS);
+    }
+
+    Drain();
+
+    return 0;
+}
+
+void FTLogWriter::Stop()
+{
+    bStopping.store(true, std::memory_order_relaxed);
+    WakeEvent->Trigger();
+}
+
+FTLogWriter::FThreadRing* FTLogWriter::GetThreadRing()
+{
+    if (SThreadRing.Ring)
+    {
+        return SThreadRing.Ring;
+    }
+
+    /* The first entry of this thread; its ring serves every writer to come.
+     * A ring handed back by an exited thread comes first. */
+    const int32 RingsInUse = FMath::Min(SRingCount.load(), MAX_THREADS);
+    for (int32 Index = 0; Index < RingsInUse; ++Index)
+    {
+        FThreadRing* Ring = SRings[Index].load();
+        bool bOwned = false;
+
+        if (Ring && !Ring->bOwned.load(std::memory_order_relaxed)
+                && Ring->bOwned.compare_exchange_strong(
+                    bOwned, true, std::memory_order_acquire))
+        {
+            SThreadRing.Ring = Ring;
+            return Ring;
+        }
+    }
+
+    /* Checked first so that threads without a ring do not keep pushing the
+     * count up. */
+    if (RingsInUse < MAX_THREADS)
+    {
+        const int32 Index = SRingCount.fetch_add(1);
+        if (Index < MAX_THREADS)
+        {
+            SThreadRing.Ring = new FThreadRing();
+            SRings[Index].store(SThreadRing.Ring);
+
+            return SThreadRing.Ring;
+        }
+    }
+
+    if (!SThreadRing.bWarned)
+    {
+        SThreadRing.bWarned = true;
+
+        UE_LOG(Log_Generic, Warning,
+               TEXT("[WARNING TLog] more than %d threads log at once; the rest"
+                    " write synchronously!"), MAX_THREADS);
+    }
+
+    return nullptr;
+}
+
+FTLogWriter* FTLogWriter::BeginPush(FThreadRing& Ring)
+{
+    /* Sequentially consistent on both sides: either Shutdown sees the flag
+     * and waits, or this thread sees the writer gone. */
+    Ring.bPushing.store(true);
+
+    FTLogWriter* Writer = SInstance.load();
+    if (!Writer)
+    {
+        EndPush(Ring);
+    }
+
+    return Writer;
+}
+
+void FTLogWriter::EndPush(FThreadRing& Ring)
+{
+    Ring.bPushing.store(false, std::memory_order_release);
+}
+
+FTLogWriter::FSlot* FTLogWriter::Claim(FThreadRing& Ring)
+{
+    const uint32 Tail = Ring.Tail.load(std::memory_order_relaxed);
+
+    if (Tail - Ring.Head.load(std::memory_order_acquire) >= CAPACITY)
+    {
+        /* The writer has not drained this slot since the last lap. */
+        return nullptr;
+    }
+
+    return &Ring.Slots[Tail & (CAPACITY - 1)];
+}
+
+void FTLogWriter::Publish(FThreadRing& Ring)
+{
+    const uint32 Tail = Ring.Tail.load(std::memory_order_relaxed) + 1;
+    Ring.Tail.store(Tail, std::memory_order_release);
+
+    if (Tail - Ring.Head.load(std::memory_order_relaxed) == WAKE_THRESHOLD)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+void FTLogWriter::Drain()
+{
+    /** The entries of a ring pushed before the drain started. */
+    struct FCursor
+    {
+        FThreadRing* Ring;
+        uint32 Position;
+        uint32 End;
+    };
+
+    TArray<FCursor, TInlineAllocator<MAX_THREADS>> Cursors;
+
+    const int32 RingsInUse = FMath::Min(
+                SRingCount.load(std::memory_order_relaxed), MAX_THREADS);
+    for (int32 Index = 0; Index < RingsInUse; ++Index)
+    {
+        /* A ring handed out but not published yet has nothing to drain. */
+        FThreadRing* Ring = SRings[Index].load(std::memory_order_acquire);
+        if (!Ring)
+        {
+            continue;
+        }
+
+        const uint32 Head = Ring->Head.load(std::memory_order_relaxed);
+        const uint32 Tail = Ring->Tail.load(std::memory_order_acquire);
+        if (Head != Tail)
+        {
+            Cursors.Add({ Ring, Head, Tail });
+        }
+    }
+
+    TArray<FOnScreenEntry> OnScreenEntries;
+
+    /* Each ring is in order already; so, the oldest entry left is always at
+     * the head of one of them. */
+    while (Cursors.Num() > 0)
+    {
+        int32 Oldest = 0;
+        for (int32 Index = 1; Index < Cursors.Num(); ++Index)
+        {
+            const FCursor& Cursor = Cursors[Index];
+            const FCursor& OldestCursor = Cursors[Oldest];
+
+            if (Cursor.Ring->Slots[Cursor.Position & (CAPACITY - 1)].Cycles
+                    < OldestCursor.Ring->Slots[
+                        OldestCursor.Position & (CAPACITY - 1)].Cycles)
+            {
+                Oldest = Index;
+            }
+        }
+
+        FCursor& Cursor = Cursors[Oldest];
+        Write(Cursor.Ring->Slots[Cursor.Position & (CAPACITY - 1)],
+              OnScreenEntries);
+
+        /* Hands the slot back to the owning thread for the next lap. */
+        ++Cursor.Position;
+        Cursor.Ring->Head.store(Cursor.Position, std::memory_order_release);
+
+        if (Cursor.Position == Cursor.End)
+        {
+            Cursors.RemoveAtSwap(Oldest, 1, false);
+        }
+    }
+
+    if (BinarySink)
+    {
+        BinarySink->Flush();
+    }
+
+    if (OnScreenEntries.Num() > 0)
+    {
+        FScopeLock Lock(&OnScreenLock);
+        PendingOnScreenEntries.Append(MoveTemp(OnScreenEntries));
+
+        /* Keeps the newest ones if the game thread falls behind. */
+        const int32 Excess =
+                PendingOnScreenEntries.Num() - static_cast<int32>(CAPACITY);
+        if (Excess > 0)
+        {
+            PendingOnScreenEntries.RemoveAt(0, Excess, false);
+        }
+    }
+
+    const uint64 Dropped = SDroppedEntries.load(std::memory_order_relaxed);
+    if (Dropped != ReportedDroppedEntries)
+    {
+        UE_LOG(Log_Generic, Warning,
+               TEXT("[WARNING TLog] %llu log entries dropped; %llu in total!"),
+               Dropped - ReportedDroppedEntries, Dropped);
+        ReportedDroppedEntries = Dropped;
+    }
+}
+
+void FTLogWriter::Write(FSlot& Slot, TArray<FOnScreenEntry>& Out_OnScreenEntries)
+{
+    const TLogSite* Site = Slot.Site;
+
+    if (Slot.bBinary)
+    {
+        if (!BinarySink)
+        {
+            BinarySink = MakeUnique<FTLogBinarySink>(StartCycles, StartTime);
+        }
+
+        BinarySink->Write(*Site, Slot.Cycles, Slot.Payload);
+        Slot.Payload.Reset();
+
+        return;
+    }
+
+    TLogCore::WriteToLog(*Site, Slot.Text.GetData());
+    Out_OnScreenEntries.Emplace(Site, FString(Slot.Text.GetData()));
+}
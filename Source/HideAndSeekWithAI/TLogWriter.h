@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <Containers/Array.h>
+#include <Containers/ContainerAllocationPolicies.h>
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <HAL/CriticalSection.h>
+#include <HAL/Runnable.h>
+#include <Misc/DateTime.h>
+#include <Templates/UniquePtr.h>
+
+#include "TLog.h"
+#include "TLogBinary.h"
+
+class FEvent;
+class FRunnableThread;
+
+/** The asynchronous sink TLog entries end up in. Every logging thread owns a
+ *  bounded lock-free single-producer single-consumer staging ring; it pushes
+ *  its finished entries there and returns right away, without touching
+ *  anything another logging thread writes to. A dedicated writer thread drains
+ *  all the rings, merging their entries by the time they were logged at, to
+ *  the log file and hands the on-screen messages back to the game thread,
+ *  which shows them in one batch at the end of the frame. So, logging from
+ *  parallel workers never makes them wait for each other.
+ *
+ *  Once a ring is full, new entries from its thread get dropped and counted
+ *  instead of blocking the thread; errors are written synchronously instead.
+ *  The writer reports the number of dropped entries to the log every time it
+ *  grows. Before the writer starts, after it stops, and on threads beyond the
+ *  ring limit, the entries are written synchronously.
+ *
+ *  The rings outlive the writers; a thread flags its ring while it pushes, so
+ *  shutting down waits for the pushes in flight before freeing the writer. A
+ *  thread hands its ring back once it exits, so the ring limit only counts
+ *  the threads logging at the same time. */
+class HIDEANDSEEKWITHAI_API FTLogWriter final : public FRunnable
+{
+public:
+    /** The number of entries the ring of each thread is able to hold; a power
+     *  of two. */
+    static constexpr uint32 CAPACITY = 256;
+
+    /** The number of threads able to own a ring at the same time. */
+    static constexpr int32 MAX_THREADS = 64;
+
+    /** The number of characters a slot holds inline. */
+    static constexpr int32 SLOT_TEXT_SIZE = 128;
+
+    /** The number of payload bytes a slot holds inline. */
+    static constexpr int32 SLOT_PAYLOAD_SIZE = 64;
+
+private:
+    /** A ring slot. */
+    struct FSlot
+    {
+        const TLogSite* Site;
+
+        /* The time the entry was logged at. */
+        uint64 Cycles;
+
+        /* The null-terminated text. A slot spills to the heap only the first
+         * time it holds a longer entry and keeps that memory afterwards, so
+         * pushing almost never allocates. */
+        TArray<TCHAR, TInlineAllocator<SLOT_TEXT_SIZE>> Text;
+
+        /* Binary entries carry the encoded arguments instead of the text. */
+        bool bBinary;
+        TArray<uint8, TInlineAllocator<SLOT_PAYLOAD_SIZE>> Payload;
+    };
+
+    /** The staging ring of a single logging thread. Only the owning thread
+     *  advances the tail and only the writer advances the head. */
+    struct FThreadRing
+    {
+        std::unique_ptr<FSlot[]> Slots;
+
+        /* The position the writer drains the next entry from. */
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head;
+
+        /* The position the owning thread pushes the next entry to. */
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail;
+
+        /* Set by the owning thread while it uses the writer. */
+        std::atomic<bool> bPushing;
+
+        /* Whether a thread owns this ring or not. */
+        std::atomic<bool> bOwned;
+
+        FThreadRing();
+    };
+
+    /** Hands the ring of a thread back once the thread exits. */
+    struct FThreadRingOwner
+    {
+        FThreadRing* Ring;
+
+        /* Whether the thread has been told it logs synchronously or not. */
+        bool bWarned;
+
+        FThreadRingOwner();
+        ~FThreadRingOwner();
+    };
+
+    /** An entry waiting for the game thread to be shown on screen. */
+    struct FOnScreenEntry
+    {
+        const TLogSite* Site;
+        FString Entry;
+
+        FOnScreenEntry(const TLogSite* InSite, FString&& InEntry);
+    };
+
+private:
+    /** The running writer, if any. */
+    static std::atomic<FTLogWriter*> SInstance;
+
+    /** The rings handed out so far. A ring is published once and stays for
+     *  the lifetime of the process, so the threads never touch freed memory
+     *  through it; once its thread exits, the next new thread reuses it. */
+    static std::atomic<FThreadRing*> SRings[MAX_THREADS];
+
+    /** The number of rings handed out so far; may overshoot MAX_THREADS. */
+    alignas(PLATFORM_CACHE_LINE_SIZE) static std::atomic<int32> SRingCount;
+
+    /** The number of entries dropped so far. */
+    alignas(PLATFORM_CACHE_LINE_SIZE) static std::atomic<uint64> SDroppedEntries;
+
+    /** The ring of the calling thread, if it has one. */
+    static thread_local FThreadRingOwner SThreadRing;
+
+    /** The number of dropped entries the writer has already reported. */
+    uint64 ReportedDroppedEntries;
+
+    /** Wakes the writer up before its interval ends once a ring fills up. */
+    FEvent* WakeEvent;
+
+    /** Asks the writer thread to quit. */
+    std::atomic<bool> bStopping;
+
+    /** The writer thread. */
+    FRunnableThread* Thread;
+
+    /** The time the writer started at, before any entry it drains got
+     *  stamped; the binary log counts its time stamps from here. */
+    uint64 StartCycles;
+
+    /** The UTC time matching StartCycles. */
+    FDateTime StartTime;
+
+    /** The binary log file; opened once the first binary entry arrives. */
+    TUniquePtr<FTLogBinarySink> BinarySink;
+
+    /** Guards the on-screen entries handed over to the game thread. */
+    FCriticalSection OnScreenLock;
+
+    /** The on-screen entries waiting for the end of the frame. */
+    TArray<FOnScreenEntry> PendingOnScreenEntries;
+
+public:
+    /** Starts the writer thread; gets called once the game module starts. */
+    static void Startup();
+
+    /** Stops the writer thread and writes whatever is left in the rings; gets
+     *  called once the game module shuts down. */
+    static void Shutdown();
+
+    /** Copies a finished entry into the ring of the calling thread. Returns
+     *  false if the caller has to write the entry synchronously. */
+    static bool Push(const TLogSite& Site, const uint64 Cycles,
+                     const TCHAR* Entry, const int32 Length);
+
+    /** Copies a binary entry into the ring of the calling thread. Binary
+     *  entries never get written synchronously; they get dropped if the ring
+     *  is full. */
+    static void PushBinary(const TLogSite& Site, const uint64 Cycles,
+                           const FTLogPayload& Payload);
+
+    /** Whether the writer thread is running or not. */
+    static bool IsRunning();
+
+    /** Shows the pending on-screen entries; gets called by the game thread at
+     *  the end of every frame. */
+    static void FlushOnScreen();
+
+    /** Returns the number of entries dropped so far. */
+    static uint64 GetDroppedEntries();
+
+public:
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    FTLogWriter();
+    virtual ~FTLogWriter();
+
+    /** Returns the ring of the calling thread, taking a free one or creating
+     *  a new one on the thread's first entry; returns nullptr while all the
+     *  rings are owned by other threads. */
+    static FThreadRing* GetThreadRing();
+
+    /** Flags the calling thread's ring as in use and returns the running
+     *  writer; returns nullptr, with the flag cleared, if there is none. */
+    static FTLogWriter* BeginPush(FThreadRing& Ring);
+
+    /** Clears the flag set by BeginPush. */
+    static void EndPush(FThreadRing& Ring);
+
+    /** Returns the next free slot of the calling thread's ring; returns
+     *  nullptr if the ring is full. */
+    static FSlot* Claim(FThreadRing& Ring);
+
+    /** Hands the slot claimed last over to the writer. */
+    void Publish(FThreadRing& Ring);
+
+    /** Drains all the entries pushed so far in the order they were logged;
+     *  only the writer thread, or the module shutdown once the thread is gone,
+     *  drains the rings. */
+    void Drain();
+
+    /** Writes a drained slot. */
+    void Write(FSlot& Slot, TArray<FOnScreenEntry>& Out_OnScreenEntries);
+};
@@ -0,0 +1,211 @@
+#include "TMatchProfiler.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Components/StaticMeshComponent.h>
+#include <Containers/Ticker.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+#include <HAL/FileManager.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/CommandLine.h>
+#include <Misc/DateTime.h>
+#include <Misc/Parse.h>
+#include <Misc/Paths.h>
+#include <ProfilingDebugging/CsvProfiler.h>
+
+#include "TLog.h"
+#include "TPickup.h"
+#include "TStats.h"
+
+static constexpr uint64 TLOG_KEY_MATCH_PROFILER = TLOG_KEY_GENERIC + 4000;
+
+static TAutoConsoleVariable<int32> CVarMatchProfiler(
+        TEXT("t.MatchProfiler"),
+        0,
+        TEXT("Captures a CSV profile per match into Saved/Profiling/CSV.\n"
+             " 0: off\n"
+             " 1: on"),
+        ECVF_Default);
+
+#if CSV_PROFILER
+CSV_DEFINE_CATEGORY(HideAndSeek, true);
+#endif  /* CSV_PROFILER */
+
+FTMatchProfiler::FTMatchProfiler()
+    : Seed(0),
+      bCapturing(false)
+{
+
+}
+
+FTMatchProfiler::~FTMatchProfiler()
+{
+    EndMatch(EMatchResults::OnGoing);
+}
+
+bool FTMatchProfiler::IsEnabled()
+{
+#if CSV_PROFILER
+    return (CVarMatchProfiler.GetValueOnGameThread() != 0
+            || FParse::Param(FCommandLine::Get(), TEXT("TMatchProfiler")));
+#else
+    return false;
+#endif  /* CSV_PROFILER */
+}
+
+void FTMatchProfiler::BeginMatch(UWorld* InWorld, const int32 InSeed)
+{
+#if CSV_PROFILER
+    if (bCapturing || !IsEnabled())
+    {
+        return;
+    }
+
+    FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+    if (CsvProfiler->IsCapturing())
+    {
+        TLOG_WARNING(TLOG_KEY_MATCH_PROFILER,
+                     "WARNING: a CSV capture is already running; skipping the"
+                     " match capture!");
+        return;
+    }
+
+    World = InWorld;
+    Seed = InSeed;
+    TimeStamp = FDateTime::Now().ToString();
+
+    CsvProfiler->BeginCapture(
+                -1, FString(),
+                FString::Printf(TEXT("Match-%s-Seed%d.csv"), *TimeStamp, Seed));
+    CsvProfiler->SetMetadata(TEXT("HideAndSeekSeed"),
+                             *FString::FromInt(Seed));
+
+    FrameEndedHandle = FTStats::OnFrameEnded.AddRaw(
+                this, &FTMatchProfiler::OnFrameEnded);
+
+    bCapturing = true;
+
+    TLOG_DISPLAY(TLOG_KEY_MATCH_PROFILER, "Match capture started!", Seed);
+#else
+    (void)InWorld;
+    (void)InSeed;
+#endif  /* CSV_PROFILER */
+}
+
+void FTMatchProfiler::EndMatch(const EMatchResults& Results)
+{
+#if CSV_PROFILER
+    if (!bCapturing)
+    {
+        return;
+    }
+
+    FTStats::OnFrameEnded.Remove(FrameEndedHandle);
+    bCapturing = false;
+
+    FString Outcome;
+    switch (Results)
+    {
+    case EMatchResults::Caught:
+        Outcome = TEXT("Caught");
+        break;
+    case EMatchResults::Won:
+        Outcome = TEXT("Won");
+        break;
+    case EMatchResults::OnGoing:
+        Outcome = TEXT("Aborted");
+        break;
+    }
+
+    FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+    CsvProfiler->SetMetadata(TEXT("HideAndSeekOutcome"), *Outcome);
+
+    /* The file gets written asynchronously; rename it once it is done. */
+    TSharedFuture<FString> FilePath = CsvProfiler->EndCapture();
+    const FString NewFileName(FString::Printf(TEXT("Match-%s-Seed%d-%s.csv"),
+                                              *TimeStamp, Seed, *Outcome));
+
+    FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+            [FilePath, NewFileName](float DeltaTime)
+    {
+        (void)DeltaTime;
+
+        if (!FilePath.IsReady())
+        {
+            return true;
+        }
+
+        const FString& OldFilePath = FilePath.Get();
+        if (!OldFilePath.IsEmpty())
+        {
+            IFileManager::Get().Move(
+                        *(FPaths::GetPath(OldFilePath) / NewFileName),
+                        *OldFilePath);
+        }
+
+        return false;
+    }));
+
+    TLOG_DISPLAY(TLOG_KEY_MATCH_PROFILER, "Match capture ended!", Seed,
+                 Outcome);
+#else
+    (void)Results;
+#endif  /* CSV_PROFILER */
+}
+
+void FTMatchProfiler::OnFrameEnded()
+{
+#if CSV_PROFILER
+    const FTFrameCounters& Counters = FTStats::LastFrameCounters;
+
+    CSV_CUSTOM_STAT(HideAndSeek, AIMs,
+                    static_cast<float>(FPlatformTime::ToMilliseconds64(
+                                           Counters.AICycles)),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, PerceptionMs,
+                    static_cast<float>(FPlatformTime::ToMilliseconds64(
+                                           Counters.PerceptionCycles)),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, PathRequests, Counters.PathRequests,
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, SightChecks, Counters.SightChecks,
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, NoiseEvents, Counters.NoiseEvents,
+                    ECsvCustomStatOp::Set);
+
+    CSV_CUSTOM_STAT(HideAndSeek, BotsIdle,
+                    FTStats::GetBotsInAIState(EAIState::Idle),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, BotsSuspicious,
+                    FTStats::GetBotsInAIState(EAIState::Suspicious),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, BotsAlerted,
+                    FTStats::GetBotsInAIState(EAIState::Alerted),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, BotsInvestigating,
+                    FTStats::GetBotsInAIState(EAIState::Investigating),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, BotsCarryingItem,
+                    FTStats::GetBotsInAIState(EAIState::CarryingItem),
+                    ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(HideAndSeek, BotsGoingBack,
+                    FTStats::GetBotsInAIState(EAIState::GoingBack),
+                    ECsvCustomStatOp::Set);
+
+    int32 MovingPickups = 0;
+    if (World.IsValid())
+    {
+        for (TActorIterator<ATPickup> ActorItr(World.Get()); ActorItr; ++ActorItr)
+        {
+            const UPrimitiveComponent* Mesh = ActorItr->GetMesh();
+            if (Mesh && Mesh->IsSimulatingPhysics() && Mesh->IsAnyRigidBodyAwake())
+            {
+                ++MovingPickups;
+            }
+        }
+    }
+
+    CSV_CUSTOM_STAT(HideAndSeek, MovingPickups, MovingPickups,
+                    ECsvCustomStatOp::Set);
+#endif  /* CSV_PROFILER */
+}
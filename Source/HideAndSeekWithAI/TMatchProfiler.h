@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Containers/UnrealString.h>
+#include <CoreTypes.h>
+#include <Delegates/IDelegateInstance.h>
+#include <UObject/WeakObjectPtrTemplates.h>
+
+#include "HideAndSeekWithAI.h"
+
+class UWorld;
+
+/** Captures one CSV profile per match. Besides the engine's own frame timings,
+ *  every frame of the capture records the AI time, the number of bots in each
+ *  AI state, path requests, sight checks, noise events and the pickup items
+ *  moving under physics. The capture is named by the layout seed and the
+ *  match outcome once the match ends.
+ *
+ *  The profiler is off by default; pass '-TMatchProfiler' on the command line
+ *  or set 't.MatchProfiler 1' to turn it on. */
+class HIDEANDSEEKWITHAI_API FTMatchProfiler
+{
+public:
+    FTMatchProfiler();
+    ~FTMatchProfiler();
+
+    /** Determines whether the per match captures are turned on or not. */
+    static bool IsEnabled();
+
+    /** Starts capturing a new match if the profiler is enabled. */
+    void BeginMatch(UWorld* InWorld, const int32 InSeed);
+
+    /** Stops capturing the current match, if any. A match which is still on
+     *  going counts as aborted. */
+    void EndMatch(const EMatchResults& Results);
+
+    /** Whether a match is being captured or not. */
+    FORCEINLINE bool IsCapturing() const
+    {
+        return bCapturing;
+    }
+
+private:
+    /** Records the gameplay counters of the frame that just ended. */
+    void OnFrameEnded();
+
+private:
+    /** The world the captured match is played in. */
+    TWeakObjectPtr<UWorld> World;
+
+    /** The layout seed of the captured match. */
+    int32 Seed;
+
+    /** The time stamp the capture file name starts with. */
+    FString TimeStamp;
+
+    /** Whether a match is being captured or not. */
+    bool bCapturing;
+
+    /** The frame counters hook used while capturing. */
+    FDelegateHandle FrameEndedHandle;
+};
@@ -0,0 +1,369 @@
+#include "TNoiseGrid.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Components/BoxComponent.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+#include <Kismet/GameplayStatics.h>
+#include <Math/UnrealMathUtility.h>
+#include <Templates/Casts.h>
+
+#include "TAICharacter.h"
+#include "TAIController.h"
+#include "TGameState.h"
+#include "TObstacle.h"
+#include "TSpawnArea.h"
+#include "TStats.h"
+
+/** The heights above the floor the bots hear at; only what stands within
+ *  these attenuates the noises. */
+static constexpr float EAR_MIN_HEIGHT = 50.0f;
+static constexpr float EAR_MAX_HEIGHT = 180.0f;
+
+/** How far below the spawn area its floor gets looked for. */
+static constexpr float FLOOR_TRACE_LENGTH = 10000.0f;
+
+/** The neighbors of a cell, with their relative distances. */
+static const int32 NEIGHBOR_X[] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int32 NEIGHBOR_Y[] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+static const float NEIGHBOR_DISTANCES[] = {
+    1.0f, 1.0f, 1.0f, 1.0f,
+    1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f
+};
+
+/** How far beyond the spawn area the grid reaches, so the bots wandering off
+ *  it still hear. */
+static constexpr float GRID_MARGIN = 2000.0f;
+
+static TAutoConsoleVariable<int32> CVarAINoiseGrid(
+        TEXT("t.AI.NoiseGrid"),
+        1,
+        TEXT("Propagates the noises over a grid instead of the hearing sense's"
+             " line of hearing traces.\n"
+             " 0: hearing sense\n"
+             " 1: noise grid"),
+        ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAINoiseObstacleAttenuation(
+        TEXT("t.AI.NoiseObstacleAttenuation"),
+        4.0f,
+        TEXT("How many times faster the noises fade going through obstacles"
+             " than through open space; 0 blocks them. Takes effect on the next"
+             " level."),
+        ECVF_Default);
+
+FTNoiseEvent::FTNoiseEvent()
+    : Id(0),
+      Location(FVector::ZeroVector),
+      Time(0.0f)
+{
+
+}
+
+UTNoiseGrid::UTNoiseGrid()
+    : bBuilt(false),
+      Origin(FVector2D::ZeroVector),
+      Width(0),
+      Height(0),
+      LatestEventId(0)
+{
+
+}
+
+bool UTNoiseGrid::IsEnabled()
+{
+    return CVarAINoiseGrid.GetValueOnGameThread() != 0;
+}
+
+bool UTNoiseGrid::ReportNoise(const FVector& Location, const float Range,
+                              AActor* Source, AActor* Instigator)
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+
+    if (!bBuilt)
+    {
+        Build();
+    }
+
+    if (Width == 0 || Height == 0)
+    {
+        return false;
+    }
+
+    /* Noises beyond the grid, e.g. past its size limit, are left to the
+     * engine's hearing sense. */
+    const int32 StartCell = ToCell(Location);
+    if (StartCell == INDEX_NONE)
+    {
+        return false;
+    }
+
+    /* Hearing through the grid counts as perception, as the engine's hearing
+     * sense does. */
+    TSTAT_PERCEPTION_SCOPE(STAT_HideAndSeek_NoisePropagation);
+
+    ++LatestEventId;
+
+    FTNoiseEvent& Event = Events[LatestEventId % MAX_EVENTS];
+    Event.Id = LatestEventId;
+    Event.Location = Location;
+    Event.Time = GetWorld()->GetTimeSeconds();
+    Event.Source = Source;
+    Event.Instigator = Instigator;
+
+    Propagate(Event, StartCell, Range);
+
+    const ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(GetWorld()));
+    if (!GameState)
+    {
+        return true;
+    }
+
+    /* One constant time sample per bot instead of one trace per bot. */
+    for (ATAICharacter* Bot : GameState->GetBots())
+    {
+        float Loudness = 0.0f;
+        const FTNoiseEvent* Heard = Bot ? Sample(Bot->GetActorLocation(),
+                                                 Loudness)
+                                        : nullptr;
+
+        if (Heard && Heard->Id == Event.Id)
+        {
+            ATAIController* Controller =
+                    Cast<ATAIController>(Bot->GetController());
+            if (Controller)
+            {
+                Controller->OnNoiseHeard(Source, Instigator);
+            }
+        }
+    }
+
+    return true;
+}
+
+const FTNoiseEvent* UTNoiseGrid::Sample(const FVector& Location,
+                                        float& Out_Loudness) const
+{
+    Out_Loudness = 0.0f;
+
+    const int32 Cell = ToCell(Location);
+    if (Cell == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    const uint32 EventId = EventIds[Cell];
+    const FTNoiseEvent& Event = Events[EventId % MAX_EVENTS];
+
+    if (EventId == 0 || Event.Id != EventId
+            || GetWorld()->GetTimeSeconds() - Event.Time > MAX_AGE)
+    {
+        return nullptr;
+    }
+
+    Out_Loudness = Loudnesses[Cell];
+    return &Event;
+}
+
+void UTNoiseGrid::Build()
+{
+    bBuilt = true;
+
+    UWorld* World = GetWorld();
+
+    const ATSpawnArea* SpawnArea = nullptr;
+    for (TActorIterator<ATSpawnArea> ActorItr(World); ActorItr; ++ActorItr)
+    {
+        SpawnArea = *ActorItr;
+        break;
+    }
+
+    if (!SpawnArea)
+    {
+        return;
+    }
+
+    const FBox SpawnBox(SpawnArea->GetArea()->Bounds.GetBox());
+    const FBox Area(SpawnBox.ExpandBy(FVector(GRID_MARGIN, GRID_MARGIN, 0.0f)));
+
+    Origin = FVector2D(Area.Min.X, Area.Min.Y);
+    Width = FMath::Clamp(FMath::CeilToInt(Area.GetSize().X / CELL_SIZE),
+                         1, MAX_CELLS_PER_AXIS);
+    Height = FMath::Clamp(FMath::CeilToInt(Area.GetSize().Y / CELL_SIZE),
+                          1, MAX_CELLS_PER_AXIS);
+
+    const int32 Cells = Width * Height;
+    Attenuations.Init(1.0f, Cells);
+    Loudnesses.Init(0.0f, Cells);
+    EventIds.Init(0, Cells);
+    Distances.Init(TNumericLimits<float>::Max(), Cells);
+
+    /* The floor under the spawn area; the obstacles are not the floor. */
+    float FloorZ = Area.Min.Z;
+    {
+        const FVector Start(Area.GetCenter() + FVector(0.0f, 0.0f, 100.0f));
+        const FVector End(Start - FVector(0.0f, 0.0f, FLOOR_TRACE_LENGTH));
+
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(NoiseGridFloor), false);
+        FHitResult Hit;
+
+        while (World->LineTraceSingleByObjectType(
+                   Hit, Start, End,
+                   FCollisionObjectQueryParams(ECC_WorldStatic), Params))
+        {
+            AActor* HitActor = Hit.GetActor();
+            if (!HitActor || !HitActor->IsA<ATObstacle>())
+            {
+                FloorZ = Hit.ImpactPoint.Z;
+                break;
+            }
+
+            Params.AddIgnoredActor(HitActor);
+        }
+    }
+
+    const ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(World));
+    if (!GameState)
+    {
+        return;
+    }
+
+    const float Attenuation = FMath::Max(
+                0.0f, CVarAINoiseObstacleAttenuation.GetValueOnGameThread());
+    const float EarMinZ = FloorZ + EAR_MIN_HEIGHT;
+    const float EarMaxZ = FloorZ + EAR_MAX_HEIGHT;
+
+    for (const FBox& Bounds : GameState->GetObstacleBounds())
+    {
+        if (Bounds.Max.Z < EarMinZ || Bounds.Min.Z > EarMaxZ)
+        {
+            continue;
+        }
+
+        /* Whatever encloses the whole spawn area, e.g. a single mesh for the
+         * entire room, is no obstacle inside it. */
+        if (Bounds.Min.X <= SpawnBox.Min.X && Bounds.Min.Y <= SpawnBox.Min.Y
+                && Bounds.Max.X >= SpawnBox.Max.X
+                && Bounds.Max.Y >= SpawnBox.Max.Y)
+        {
+            continue;
+        }
+
+        const int32 MinX = FMath::Max(
+                    0, FMath::FloorToInt((Bounds.Min.X - Origin.X) / CELL_SIZE));
+        const int32 MaxX = FMath::Min(
+                    Width - 1,
+                    FMath::FloorToInt((Bounds.Max.X - Origin.X) / CELL_SIZE));
+        const int32 MinY = FMath::Max(
+                    0, FMath::FloorToInt((Bounds.Min.Y - Origin.Y) / CELL_SIZE));
+        const int32 MaxY = FMath::Min(
+                    Height - 1,
+                    FMath::FloorToInt((Bounds.Max.Y - Origin.Y) / CELL_SIZE));
+
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            for (int32 X = MinX; X <= MaxX; ++X)
+            {
+                Attenuations[Y * Width + X] = Attenuation;
+            }
+        }
+    }
+}
+
+void UTNoiseGrid::Propagate(const FTNoiseEvent& Event, const int32 StartCell,
+                            const float Range)
+{
+    if (Range <= 0.0f)
+    {
+        return;
+    }
+
+    /* Only the cells reached by the previous noise need resetting. */
+    for (const int32 Cell : ReachedCells)
+    {
+        Distances[Cell] = TNumericLimits<float>::Max();
+    }
+    ReachedCells.Reset();
+    OpenCells.Reset();
+
+    Distances[StartCell] = 0.0f;
+    ReachedCells.Add(StartCell);
+    OpenCells.HeapPush(FTOpenCell{ 0.0f, StartCell });
+
+    while (OpenCells.Num() > 0)
+    {
+        FTOpenCell Open;
+        OpenCells.HeapPop(Open, false);
+
+        if (Open.Distance > Distances[Open.Cell])
+        {
+            continue;
+        }
+
+        Loudnesses[Open.Cell] = 1.0f - Open.Distance / Range;
+        EventIds[Open.Cell] = Event.Id;
+
+        const int32 X = Open.Cell % Width;
+        const int32 Y = Open.Cell / Width;
+
+        for (int32 Neighbor = 0;
+             Neighbor < static_cast<int32>(UE_ARRAY_COUNT(NEIGHBOR_X));
+             ++Neighbor)
+        {
+            const int32 NeighborX = X + NEIGHBOR_X[Neighbor];
+            const int32 NeighborY = Y + NEIGHBOR_Y[Neighbor];
+
+            if (NeighborX < 0 || NeighborX >= Width
+                    || NeighborY < 0 || NeighborY >= Height)
+            {
+                continue;
+            }
+
+            const int32 NeighborCell = NeighborY * Width + NeighborX;
+
+            if (Attenuations[NeighborCell] <= 0.0f)
+            {
+                continue;
+            }
+
+            /* The noise crosses half of each cell on its way. */
+            const float Attenuation = 0.5f * (Attenuations[Open.Cell]
+                                              + Attenuations[NeighborCell]);
+
+            const float Distance = Open.Distance + NEIGHBOR_DISTANCES[Neighbor]
+                    * CELL_SIZE * Attenuation;
+
+            if (Distance >= Range || Distance >= Distances[NeighborCell])
+            {
+                continue;
+            }
+
+            if (Distances[NeighborCell] == TNumericLimits<float>::Max())
+            {
+                ReachedCells.Add(NeighborCell);
+            }
+
+            Distances[NeighborCell] = Distance;
+            OpenCells.HeapPush(FTOpenCell{ Distance, NeighborCell });
+        }
+    }
+}
+
+int32 UTNoiseGrid::ToCell(const FVector& Location) const
+{
+    const int32 X = FMath::FloorToInt((Location.X - Origin.X) / CELL_SIZE);
+    const int32 Y = FMath::FloorToInt((Location.Y - Origin.Y) / CELL_SIZE);
+
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return INDEX_NONE;
+    }
+
+    return Y * Width + X;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <Math/Box.h>
+#include <Math/Vector.h>
+#include <Subsystems/WorldSubsystem.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/WeakObjectPtrTemplates.h>
+
+#include "TNoiseGrid.generated.h"
+
+class AActor;
+
+/** A noise made by a thrown item. */
+struct HIDEANDSEEKWITHAI_API FTNoiseEvent
+{
+    /** The sequence number of the noise; zero is no noise. */
+    uint32 Id;
+
+    /** Where the noise was made */
+    FVector Location;
+
+    /** The world time the noise was made */
+    float Time;
+
+    /** The item making the noise */
+    TWeakObjectPtr<AActor> Source;
+
+    /** The character responsible for the noise */
+    TWeakObjectPtr<AActor> Instigator;
+
+    FTNoiseEvent();
+};
+
+/** Propagates the noises over a grid covering the spawn area, instead of each
+ *  bot tracing its line of hearing to each noise. A noise spreads from its
+ *  cell as a Dijkstra search bounded by its range; the obstacles and the
+ *  static level geometry at ear height attenuate it, or block it if
+ *  't.AI.NoiseObstacleAttenuation' is 0, so it travels around them. Every
+ *  cell reached keeps the loudness of the latest noise, so any bot samples
+ *  what it hears in constant time. 't.AI.NoiseGrid 0' falls back to the
+ *  engine's hearing sense. */
+UCLASS()
+class HIDEANDSEEKWITHAI_API UTNoiseGrid : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** The size of a cell in centimeters. */
+    static constexpr float CELL_SIZE = 100.0f;
+
+    /** The most cells the grid covers along one axis. */
+    static constexpr int32 MAX_CELLS_PER_AXIS = 512;
+
+    /** The number of recent noises kept. */
+    static constexpr int32 MAX_EVENTS = 32;
+
+    /** How long a noise stays audible in seconds. */
+    static constexpr float MAX_AGE = 10.0f;
+
+private:
+    /** A cell waiting in the propagation queue. */
+    struct FTOpenCell
+    {
+        float Distance;
+        int32 Cell;
+
+        FORCEINLINE bool operator<(const FTOpenCell& Other) const
+        {
+            return Distance < Other.Distance;
+        }
+    };
+
+    /** Whether the grid has been built or not. */
+    bool bBuilt;
+
+    /** The world location of the corner of the first cell. */
+    FVector2D Origin;
+
+    /** The number of cells along X */
+    int32 Width;
+
+    /** The number of cells along Y */
+    int32 Height;
+
+    /** How much each cell attenuates the noises going through it; 1 is open
+     *  space, 0 blocks them. */
+    TArray<float> Attenuations;
+
+    /** The loudness of the latest noise reaching each cell, from 0 to 1. */
+    TArray<float> Loudnesses;
+
+    /** The latest noise reaching each cell. */
+    TArray<uint32> EventIds;
+
+    /** The recent noises, indexed by their id. */
+    FTNoiseEvent Events[MAX_EVENTS];
+
+    /** The id of the latest noise. */
+    uint32 LatestEventId;
+
+    /** The distance travelled to each cell by the noise propagating; kept
+     *  around to reuse the memory. */
+    TArray<float> Distances;
+
+    /** The cells reached by the noise propagating. */
+    TArray<int32> ReachedCells;
+
+    /** The propagation queue, as a heap. */
+    TArray<FTOpenCell> OpenCells;
+
+public:
+    UTNoiseGrid();
+
+    /** Propagates a noise and lets the bots hearing it know; returns false if
+     *  the grid is off, the level has no spawn area to build it on, or the
+     *  noise is outside of the grid. */
+    bool ReportNoise(const FVector& Location, const float Range,
+                     AActor* Source, AActor* Instigator);
+
+    /** Returns the loudness of the latest noise audible at a location, from
+     *  0 to 1, and the noise itself; null if nothing is audible. */
+    const FTNoiseEvent* Sample(const FVector& Location,
+                               float& Out_Loudness) const;
+
+    /** Determines whether the noise grid is on or not. */
+    static bool IsEnabled();
+
+private:
+    /** Builds the grid over the spawn area of the level. */
+    void Build();
+
+    /** Spreads a noise over the cells from the cell it was made in. */
+    void Propagate(const FTNoiseEvent& Event, const int32 StartCell,
+                   const float Range);
+
+    /** Returns the cell of a location, or INDEX_NONE outside the grid. */
+    int32 ToCell(const FVector& Location) const;
+};
@@ -2,6 +2,10 @@
 #include "HideAndSeekWithAI.h"
 
 #include <Components/StaticMeshComponent.h>
+#include <Kismet/GameplayStatics.h>
+#include <Templates/Casts.h>
+
+#include "TGameState.h"
 
 ATObstacle::ATObstacle(
         const FObjectInitializer& ObjectInitializer)
@@ -24,3 +28,15 @@ ATObstacle::ATObstacle(
 
     SetRootComponent(Mesh);
 }
+
+void ATObstacle::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(GetWorld()));
+    if (GameState)
+    {
+        GameState->RegisterObstacleBounds(GetComponentsBoundingBox());
+    }
+}
@@ -17,4 +17,7 @@ protected:
     /** The mesh that visually represents this obstacle. */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Obstacle")
     UStaticMeshComponent* Mesh;
+
+protected:
+    virtual void BeginPlay() override;
 };
@@ -5,33 +5,57 @@
 #include <Components/BoxComponent.h>
 #include <Components/PrimitiveComponent.h>
 #include <Components/StaticMeshComponent.h>
-#include <DrawDebugHelpers.h>
+#include <Engine/World.h>
+#include <HAL/IConsoleManager.h>
 #include <Kismet/GameplayStatics.h>
 #include <Math/UnrealMathUtility.h>
+#include <Misc/CommandLine.h>
+#include <Misc/Parse.h>
 #include <Templates/Casts.h>
 
 #include "TCharacter.h"
 #include "TGameMode.h"
+#include "TGameState.h"
 #include "TLog.h"
+#include "TNoiseGrid.h"
+#include "TObstacle.h"
 #include "TPlayerCharacter.h"
+#include "TStats.h"
+#include "TTrajectoryRenderer.h"
 
 static constexpr uint64 TLOG_KEY_ITEM_THROW = TLOG_KEY_GENERIC + 3000;
 static constexpr uint64 TLOG_KEY_ITEM_THROW_BOUNCE =
         TLOG_KEY_ITEM_THROW + 1;
-static constexpr uint64 TLOG_KEY_ITEM_THROW_BOUNCE_COLOR =
-        TLOG_KEY_ITEM_THROW_BOUNCE + 1;
+/* TLOG_KEY_ITEM_THROW_BOUNCE + 1 used to be the bounce color; it stays
+ * reserved so the keys in the rate limits keep their meaning. */
 static constexpr uint64 TLOG_KEY_ITEM_THROW_BOUNCE_NOISE =
-        TLOG_KEY_ITEM_THROW_BOUNCE_COLOR + 1;
+        TLOG_KEY_ITEM_THROW_BOUNCE + 2;
+
+/** How far below a pickup item its floor gets looked for. */
+static constexpr float FLOOR_TRACE_LENGTH = 10000.0f;
+
+static TAutoConsoleVariable<int32> CVarPickupDeterministic(
+        TEXT("t.Pickup.Deterministic"),
+        0,
+        TEXT("Integrates the flights of the thrown pickup items at a fixed"
+             " step, so the same throw always lands on the same spot.\n"
+             " 0: physics engine\n"
+             " 1: deterministic"),
+        ECVF_Default);
 
 ATPickup::ATPickup(
         const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
+    /* Resting pickup items have nothing to do on tick; the ticking follows
+     * the physics body waking up and going to sleep. */
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     Mesh = ObjectInitializer.CreateDefaultSubobject<UStaticMeshComponent>(
                 this, TEXT("Mesh"));
     Mesh->SetNotifyRigidBodyCollision(true);
+    Mesh->BodyInstance.bGenerateWakeEvents = true;
     Mesh->SetCanEverAffectNavigation(false);
 
     static ConstructorHelpers::FObjectFinder<UStaticMesh> PickupMesh(
@@ -73,6 +97,9 @@ ATPickup::ATPickup(
 
     AttachedCharacter = nullptr;
 
+    FlightFloorZ = 0.0f;
+    FlightExtent = FVector::ZeroVector;
+
     CurrentTraceColorIndex = -1;
 }
 
@@ -85,6 +112,8 @@ void ATPickup::NotifyHit(UPrimitiveComponent* MyComp,
                           FVector NormalImpulse,
                           const FHitResult& Hit)
 {
+    TSTAT_SCOPE(STAT_HideAndSeek_PickupNotifyHit);
+
     Super::NotifyHit(MyComp, Other, OtherComp, bSelfMoved,
                      HitLocation, HitNormal, NormalImpulse, Hit);
 
@@ -103,41 +132,22 @@ void ATPickup::NotifyHit(UPrimitiveComponent* MyComp,
                      HitLocation, HitNormal, NormalImpulse);
     }
 
-    int32 Color = CurrentTraceColorIndex;
-    while (Color == CurrentTraceColorIndex)
-    {
-        Color = FMath::RandRange(0, TraceColors.Num() - 1);
-    }
-    CurrentTraceColorIndex = Color;
-
-    if (PreviousOwner && PreviousOwner->IsA<ATPlayerCharacter>())
-    {
-        FName Tag(*FString::Printf(TEXT("%s_%s"), TEXT(T_NOISE),
-                                   *UKismetSystemLibrary::GetDisplayName(this)));
-
-        TLOG_WARNING(TLOG_KEY_ITEM_THROW_BOUNCE_NOISE,
-                     TEXT("Making noise!"),
-                     Cast<AActor>(PreviousOwner), GetActorLocation(),
-                     MaxThrowingNoiseRange, Tag);
-
-        MakeNoise(1, PreviousOwner, GetActorLocation(),
-                  MaxThrowingNoiseRange, Tag);
-    }
+    Bounce(GetActorLocation());
 }
 
 void ATPickup::Tick(float DeltaSeconds)
 {
     Super::Tick(DeltaSeconds);
 
-    if (IsMoving())
+    if (Integrator.IsActive())
     {
-        TLOG_WARNING(TLOG_KEY_ITEM_THROW_BOUNCE_COLOR,
-                     TEXT("Current bounce color index!"),
-                     CurrentTraceColorIndex);
+        AdvanceFlight(DeltaSeconds);
+    }
 
-        DrawDebugLine(GetWorld(), GetActorLocation(),
-                      GetActorLocation() + GetVelocity() * DeltaSeconds,
-                      TraceColors[CurrentTraceColorIndex], false, 4.0f, 0, 1.0f);
+    if (IsMoving())
+    {
+        Trajectory.Add(GetActorLocation(), GetWorld()->GetTimeSeconds(),
+                       static_cast<uint8>(CurrentTraceColorIndex));
     }
 }
 
@@ -145,22 +155,7 @@ void ATPickup::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
 
-    TraceColors.AddUnique(FColor::White);
-    TraceColors.AddUnique(FColor::Black);
-    TraceColors.AddUnique(FColor::Transparent);
-    TraceColors.AddUnique(FColor::Red);
-    TraceColors.AddUnique(FColor::Green);
-    TraceColors.AddUnique(FColor::Blue);
-    TraceColors.AddUnique(FColor::Yellow);
-    TraceColors.AddUnique(FColor::Cyan);
-    TraceColors.AddUnique(FColor::Magenta);
-    TraceColors.AddUnique(FColor::Orange);
-    TraceColors.AddUnique(FColor::Purple);
-    TraceColors.AddUnique(FColor::Turquoise);
-    TraceColors.AddUnique(FColor::Silver);
-    TraceColors.AddUnique(FColor::Emerald);
-
-    CurrentTraceColorIndex = FMath::RandRange(0, TraceColors.Num() - 1);
+    CurrentTraceColorIndex = FMath::RandRange(0, FTPickupTrajectory::COLORS - 1);
 }
 
 void ATPickup::BeginPlay()
@@ -171,16 +166,37 @@ void ATPickup::BeginPlay()
                 this, &ATPickup::OnOverlapBegins);
     Trigger->OnComponentEndOverlap.AddDynamic(
                 this, &ATPickup::OnOverlapEnds);
+    Mesh->OnComponentWake.AddDynamic(this, &ATPickup::OnMeshWake);
+    Mesh->OnComponentSleep.AddDynamic(this, &ATPickup::OnMeshSleep);
+
+    /* Whatever the pickup class sets up is what gets restored after each
+     * hold. */
+    FreeMeshResponses = Mesh->GetCollisionResponseToChannels();
+    FreeTriggerResponses = Trigger->GetCollisionResponseToChannels();
+
+    if (UTTrajectoryRenderer* Renderer =
+            GetWorld()->GetSubsystem<UTTrajectoryRenderer>())
+    {
+        Renderer->Register(this);
+    }
 }
 
 void ATPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
 
+    if (UTTrajectoryRenderer* Renderer =
+            GetWorld()->GetSubsystem<UTTrajectoryRenderer>())
+    {
+        Renderer->Unregister(this);
+    }
+
     Trigger->OnComponentBeginOverlap.RemoveDynamic(
                 this, &ATPickup::OnOverlapBegins);
     Trigger->OnComponentEndOverlap.RemoveDynamic(
                 this, &ATPickup::OnOverlapEnds);
+    Mesh->OnComponentWake.RemoveDynamic(this, &ATPickup::OnMeshWake);
+    Mesh->OnComponentSleep.RemoveDynamic(this, &ATPickup::OnMeshSleep);
 }
 
 void ATPickup::OnOverlapBegins(
@@ -241,6 +257,27 @@ void ATPickup::OnOverlapEnds(
     }
 }
 
+void ATPickup::OnMeshWake(UPrimitiveComponent* WakingComponent,
+                          FName BoneName)
+{
+    (void)WakingComponent;
+    (void)BoneName;
+
+    if (!IsAttachedToACharacter())
+    {
+        SetActorTickEnabled(true);
+    }
+}
+
+void ATPickup::OnMeshSleep(UPrimitiveComponent* SleepingComponent,
+                           FName BoneName)
+{
+    (void)SleepingComponent;
+    (void)BoneName;
+
+    SetActorTickEnabled(false);
+}
+
 void ATPickup::AttachToCharacter(ATCharacter* Character)
 {
     if (!Character)
@@ -268,15 +305,15 @@ void ATPickup::AttachToCharacter(ATCharacter* Character)
         SetVisibility(false);
     }
 
-    Mesh->SetEnableGravity(false);
-    Mesh->SetSimulatePhysics(false);
-    SetActorEnableCollision(false);
+    BeginHold();
 
+    /* Keeping the relative scale spares rescaling the physics body on each
+     * pickup and drop. */
     RootComponent->AttachToComponent(
                 Character->GetItemAttachPoint(),
                 FAttachmentTransformRules(EAttachmentRule::SnapToTarget,
                                           EAttachmentRule::SnapToTarget,
-                                          EAttachmentRule::SnapToTarget,
+                                          EAttachmentRule::KeepRelative,
                                           true));
 
     if (Character->IsA<ATPlayerCharacter>())
@@ -306,15 +343,15 @@ void ATPickup::DetachFromCharacter(ATCharacter* Character)
 
     PreviousOwner = AttachedCharacter;
 
+    /* Each throw or drop starts a new flight. */
+    Trajectory.Reset();
+
     RootComponent->DetachFromComponent(
                 FDetachmentTransformRules(EDetachmentRule::KeepWorld,
                                           EDetachmentRule::KeepWorld,
-                                          EDetachmentRule::KeepWorld,
+                                          EDetachmentRule::KeepRelative,
                                           true));
 
-    ATPickup* DefaultObject = GetClass()->GetDefaultObject<ATPickup>();
-    Mesh->SetRelativeScale3D(DefaultObject->GetMesh()->GetRelativeScale3D());
-
     AttachedCharacter = nullptr;
 
     if (Character->IsA<ATPlayerCharacter>())
@@ -322,18 +359,174 @@ void ATPickup::DetachFromCharacter(ATCharacter* Character)
         SetVisibility(true);
     }
 
-    SetActorEnableCollision(true);
-    Mesh->SetEnableGravity(true);
-    Mesh->SetSimulatePhysics(true);
+    if (IsDeterministic())
+    {
+        /* Falls from the hands unless it gets launched. */
+        EndHold(false);
+        BeginFlight(FVector::ZeroVector);
+        return;
+    }
+
+    EndHold(true);
+
+    /* Ticks through the flight until the body goes to sleep. */
+    SetActorTickEnabled(true);
+}
+
+void ATPickup::Launch(const FVector& Velocity)
+{
+    if (IsAttachedToACharacter())
+    {
+        return;
+    }
+
+    if (Integrator.IsActive())
+    {
+        BeginFlight(Velocity);
+        return;
+    }
+
+    Mesh->AddImpulse(Velocity, NAME_None, true);
+}
+
+bool ATPickup::IsDeterministic()
+{
+    static const bool bCommandLine =
+            FParse::Param(FCommandLine::Get(), TEXT("TDeterministicPickups"));
+
+    return bCommandLine || CVarPickupDeterministic.GetValueOnGameThread() != 0;
+}
+
+void ATPickup::BeginHold()
+{
+    Integrator.Stop();
+    SetActorTickEnabled(false);
+
+    /* A kinematic body cannot be put to sleep, so it sleeps first. The
+     * collision stays enabled, as switching it off would recreate the physics
+     * state; ignoring every channel only updates the filter data of the
+     * shapes. */
+    Mesh->PutRigidBodyToSleep();
+    Mesh->SetSimulatePhysics(false);
+    Mesh->SetCollisionResponseToAllChannels(ECR_Ignore);
+
+    /* The trigger would otherwise keep overlapping the carrier. */
+    Trigger->SetCollisionResponseToAllChannels(ECR_Ignore);
+}
+
+void ATPickup::EndHold(const bool bSimulatePhysics)
+{
+    Mesh->SetCollisionResponseToChannels(FreeMeshResponses);
+    Trigger->SetCollisionResponseToChannels(FreeTriggerResponses);
+
+    if (bSimulatePhysics)
+    {
+        Mesh->SetSimulatePhysics(true);
+        Mesh->WakeRigidBody();
+    }
+}
+
+void ATPickup::Bounce(const FVector& Location)
+{
+    int32 Color = CurrentTraceColorIndex;
+    while (Color == CurrentTraceColorIndex)
+    {
+        Color = FMath::RandRange(0, FTPickupTrajectory::COLORS - 1);
+    }
+    CurrentTraceColorIndex = Color;
+
+    if (PreviousOwner && PreviousOwner->IsA<ATPlayerCharacter>())
+    {
+        FName Tag(*FString::Printf(TEXT("%s_%s"), TEXT(T_NOISE),
+                                   *UKismetSystemLibrary::GetDisplayName(this)));
+
+        TLOG_WARNING(TLOG_KEY_ITEM_THROW_BOUNCE_NOISE,
+                     TEXT("Making noise!"),
+                     Cast<AActor>(PreviousOwner), Location,
+                     MaxThrowingNoiseRange, Tag);
+
+        TSTAT_INC_FRAME_COUNTER(NoiseEvents);
+
+        UTNoiseGrid* NoiseGrid = GetWorld()->GetSubsystem<UTNoiseGrid>();
+        if (!NoiseGrid || !NoiseGrid->ReportNoise(Location, MaxThrowingNoiseRange,
+                                                  this, PreviousOwner))
+        {
+            MakeNoise(1, PreviousOwner, Location, MaxThrowingNoiseRange, Tag);
+        }
+    }
+}
+
+void ATPickup::BeginFlight(const FVector& Velocity)
+{
+    /* The physics engine stays out of the deterministic flights; the body
+     * is still kinematic from the held mode. */
+    FlightFloorZ = FindFloorZ();
+    FlightExtent = Mesh->Bounds.BoxExtent;
+
+    Integrator.Launch(GetActorLocation(), Velocity);
+    Mesh->ComponentVelocity = Velocity;
+
+    SetActorTickEnabled(true);
+}
+
+void ATPickup::AdvanceFlight(const float DeltaSeconds)
+{
+    const ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(GetWorld()));
+    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
+
+    FlightBounces.Reset();
+    Integrator.Advance(DeltaSeconds, GetWorld()->GetGravityZ(), FlightFloorZ,
+                       FlightExtent, GameState->GetObstacleBounds(),
+                       FlightBounces);
+
+    SetActorLocation(Integrator.GetLocation());
+    Mesh->ComponentVelocity = Integrator.GetVelocity();
+
+    for (const FVector& Location : FlightBounces)
+    {
+        TLOG_WARNING(TLOG_KEY_ITEM_THROW_BOUNCE,
+                     TEXT("Thrown item hit!"), Location);
+
+        Bounce(Location);
+    }
+
+    if (!Integrator.IsActive())
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+float ATPickup::FindFloorZ() const
+{
+    const FVector Start(GetActorLocation());
+    const FVector End(Start - FVector(0.0f, 0.0f, FLOOR_TRACE_LENGTH));
+
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(PickupFloor), false, this);
+    FHitResult Hit;
+
+    /* The obstacles are boxes the flight bounces off on its own. */
+    while (GetWorld()->LineTraceSingleByObjectType(
+               Hit, Start, End,
+               FCollisionObjectQueryParams(ECC_WorldStatic), Params))
+    {
+        AActor* HitActor = Hit.GetActor();
+        if (!HitActor || !HitActor->IsA<ATObstacle>())
+        {
+            return Hit.ImpactPoint.Z;
+        }
+
+        Params.AddIgnoredActor(HitActor);
+    }
+
+    return End.Z;
 }
 
 void ATPickup::SetVisibility(const bool bVisibility)
 {
-    /* It makes sense to disable tick and collisions in addition to hiding the
-     * pickup item in order to avoid unwanted behaviors and bugs. */
+    /* The collisions and the ticking follow the held mode and the physics
+     * body instead. */
     SetActorHiddenInGame(!bVisibility);
-    SetActorEnableCollision(bVisibility);
-    SetActorTickEnabled(bVisibility);
 }
 
 bool ATPickup::IsMoving() const
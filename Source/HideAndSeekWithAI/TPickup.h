@@ -1,9 +1,12 @@
 #pragma once
 
-#include <Containers/Array.h>
+#include <Engine/EngineTypes.h>
 #include <GameFramework/Actor.h>
 #include <UObject/ObjectMacros.h>
 
+#include "TPickupIntegrator.h"
+#include "TPickupTrajectory.h"
+
 #include "TPickup.generated.h"
 
 class UBoxComponent;
@@ -46,16 +49,34 @@ private:
     UPROPERTY(Transient)
     ATCharacter* PreviousOwner;
 
-    /** An array of colors used for drawing the traverse path of this pickup
-     *  item when it is thrown. */
-    UPROPERTY(Transient)
-    TArray<FColor> TraceColors;
-
     /** Caches the current color used for drawing the traverse path of this pickup
      *  item when it is thrown. */
     UPROPERTY(Transient)
     int32 CurrentTraceColorIndex;
 
+    /** The recent flight of this pickup item. */
+    FTPickupTrajectory Trajectory;
+
+    /** Integrates the flight in the deterministic mode. */
+    FTPickupIntegrator Integrator;
+
+    /** The floor height under this pickup item when its flight started. */
+    float FlightFloorZ;
+
+    /** The extent of this pickup item when its flight started. */
+    FVector FlightExtent;
+
+    /** The bounces of the current frame; kept around to reuse the memory. */
+    TArray<FVector> FlightBounces;
+
+    /** The collision responses of the mesh while this pickup item is not
+     *  held. */
+    FCollisionResponseContainer FreeMeshResponses;
+
+    /** The collision responses of the trigger while this pickup item is not
+     *  held. */
+    FCollisionResponseContainer FreeTriggerResponses;
+
 public:
     virtual void NotifyHit(UPrimitiveComponent* MyComp,
                            AActor* Other,
@@ -94,6 +115,18 @@ protected:
             UPrimitiveComponent* OtherComp,
             int32 OtherBodyIndex);
 
+    /** Fires when the physics body of this pickup item wakes up; the pickup
+     *  item ticks while its body is awake. */
+    UFUNCTION()
+    virtual void OnMeshWake(UPrimitiveComponent* WakingComponent,
+                            FName BoneName);
+
+    /** Fires when the physics body of this pickup item goes to sleep; the
+     *  pickup item stops ticking until the body wakes up again. */
+    UFUNCTION()
+    virtual void OnMeshSleep(UPrimitiveComponent* SleepingComponent,
+                             FName BoneName);
+
 public:
     /** Returns the original spawn point of the bot. */
     FORCEINLINE const FVector& GetSpawnPoint() const
@@ -107,6 +140,12 @@ public:
         SpawnPoint = Location;
     }
 
+    /** Returns the recent flight of the pickup item. */
+    FORCEINLINE const FTPickupTrajectory& GetTrajectory() const
+    {
+        return Trajectory;
+    }
+
     /** Returns the mesh representing the pickup item */
     FORCEINLINE UStaticMeshComponent* GetMesh() const
     {
@@ -131,11 +170,43 @@ public:
     /** Detaches this pickup item to a character. */
     void DetachFromCharacter(ATCharacter* Character);
 
+    /** Launches this pickup item at a velocity, once detached. */
+    void Launch(const FVector& Velocity);
+
+    /** Determines whether the thrown pickup items fly deterministically or
+     *  not. Turned on by 't.Pickup.Deterministic' or '-TDeterministicPickups';
+     *  the flights then get integrated at a fixed step against the floor and
+     *  the static boxes instead of being simulated by the physics engine, so
+     *  the same throw always lands on the same spot. */
+    static bool IsDeterministic();
+
 private:
+    /** Puts this pickup item into the held mode; the physics body stays
+     *  allocated but turns kinematic and dormant, and the mesh and the trigger
+     *  ignore every channel. */
+    void BeginHold();
+
+    /** Takes this pickup item out of the held mode; the physics body only
+     *  gets simulated again when the physics engine flies it. */
+    void EndHold(const bool bSimulatePhysics);
+
+    /** Reacts to a bounce off anything; picks the next trace color and makes
+     *  noise. */
+    void Bounce(const FVector& Location);
+
+    /** Starts a deterministic flight. */
+    void BeginFlight(const FVector& Velocity);
+
+    /** Integrates the deterministic flight over a frame. */
+    void AdvanceFlight(const float DeltaSeconds);
+
+    /** Finds the floor below this pickup item, ignoring the obstacles. */
+    float FindFloorZ() const;
+
     /** Sets the visibility of this item inside the game. */
     void SetVisibility(const bool bVisibility);
 
     /** Determines whether this object is moving or not used internally for
-     *  drawing the path this item is moving on. */
+     *  recording the path this item is moving on. */
     bool IsMoving() const;
 };
@@ -0,0 +1,135 @@
+#include "TPickupIntegrator.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Math/UnrealMathUtility.h>
+
+FTPickupIntegrator::FTPickupIntegrator()
+    : Location(FVector::ZeroVector),
+      Velocity(FVector::ZeroVector),
+      Accumulator(0.0f),
+      bActive(false)
+{
+
+}
+
+void FTPickupIntegrator::Launch(const FVector& InLocation,
+                                const FVector& InVelocity)
+{
+    Location = InLocation;
+    Velocity = InVelocity;
+    Accumulator = 0.0f;
+    bActive = true;
+}
+
+void FTPickupIntegrator::Stop()
+{
+    Velocity = FVector::ZeroVector;
+    Accumulator = 0.0f;
+    bActive = false;
+}
+
+void FTPickupIntegrator::Advance(const float DeltaSeconds, const float GravityZ,
+                                 const float FloorZ, const FVector& Extent,
+                                 const TArray<FBox>& Obstacles,
+                                 TArray<FVector>& Out_Bounces)
+{
+    if (!bActive)
+    {
+        return;
+    }
+
+    Accumulator = FMath::Min(Accumulator + DeltaSeconds,
+                             FIXED_STEP * MAX_STEPS_PER_FRAME);
+
+    while (bActive && Accumulator >= FIXED_STEP)
+    {
+        Accumulator -= FIXED_STEP;
+
+        const bool bSupported =
+                Step(GravityZ, FloorZ, Extent, Obstacles, Out_Bounces);
+
+        if (bSupported && Velocity.SizeSquared() < REST_SPEED * REST_SPEED)
+        {
+            Stop();
+        }
+    }
+}
+
+bool FTPickupIntegrator::Step(const float GravityZ, const float FloorZ,
+                              const FVector& Extent,
+                              const TArray<FBox>& Obstacles,
+                              TArray<FVector>& Out_Bounces)
+{
+    bool bContact = false;
+
+    /* Semi-implicit Euler; the velocity first, then the location. */
+    Velocity.Z += GravityZ * FIXED_STEP;
+
+    const FVector PreviousLocation(Location);
+    Location += Velocity * FIXED_STEP;
+
+    const float MinZ = FloorZ + Extent.Z;
+    if (Location.Z < MinZ)
+    {
+        Location.Z = MinZ;
+        Bounce(2, 1.0f, Out_Bounces);
+        bContact = true;
+    }
+
+    for (const FBox& Obstacle : Obstacles)
+    {
+        const FBox Box(Obstacle.ExpandBy(Extent));
+        if (!Box.IsInside(Location))
+        {
+            continue;
+        }
+
+        /* The item came in through the face it was outside of during the
+         * previous step; pushes it back out through that face. */
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            float Normal = 0.0f;
+
+            if (PreviousLocation[Axis] <= Box.Min[Axis])
+            {
+                Location[Axis] = Box.Min[Axis];
+                Normal = -1.0f;
+            }
+            else if (PreviousLocation[Axis] >= Box.Max[Axis])
+            {
+                Location[Axis] = Box.Max[Axis];
+                Normal = 1.0f;
+            }
+            else
+            {
+                continue;
+            }
+
+            Bounce(Axis, Normal, Out_Bounces);
+            bContact = true;
+            break;
+        }
+    }
+
+    return bContact;
+}
+
+void FTPickupIntegrator::Bounce(const int32 Axis, const float Normal,
+                                TArray<FVector>& Out_Bounces)
+{
+    const float NormalSpeed = Velocity[Axis];
+
+    /* Already moving away from the face. */
+    if (NormalSpeed * Normal >= 0.0f)
+    {
+        return;
+    }
+
+    Velocity *= FRICTION;
+    Velocity[Axis] = -NormalSpeed * RESTITUTION;
+
+    if (FMath::Abs(NormalSpeed) >= MIN_BOUNCE_SPEED)
+    {
+        Out_Bounces.Add(Location);
+    }
+}
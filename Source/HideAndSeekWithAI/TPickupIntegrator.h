@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <Math/Box.h>
+#include <Math/Vector.h>
+
+/** Integrates the flight of a thrown pickup item at a fixed step, as an axis
+ *  aligned box bouncing off the floor plane and the static obstacle boxes.
+ *  The outcome only depends on the launch and the number of steps taken; so,
+ *  the same launch lands on the very same spot no matter the frame times. */
+class HIDEANDSEEKWITHAI_API FTPickupIntegrator
+{
+public:
+    /** The fixed step in seconds. */
+    static constexpr float FIXED_STEP = 1.0f / 120.0f;
+
+    /** The most steps taken in a single frame; long frames slow the flight
+     *  down instead of changing it. */
+    static constexpr int32 MAX_STEPS_PER_FRAME = 16;
+
+    /** The ratio of the speed kept along the contact normal after a bounce. */
+    static constexpr float RESTITUTION = 0.35f;
+
+    /** The ratio of the speed kept along the contact surface after a
+     *  bounce. */
+    static constexpr float FRICTION = 0.8f;
+
+    /** The slowest impact that still counts as a bounce. */
+    static constexpr float MIN_BOUNCE_SPEED = 50.0f;
+
+    /** The speed below which a supported item comes to rest. */
+    static constexpr float REST_SPEED = 10.0f;
+
+private:
+    /** The location of the item's center */
+    FVector Location;
+
+    /** The velocity of the item */
+    FVector Velocity;
+
+    /** The frame time not integrated yet */
+    float Accumulator;
+
+    /** Whether the item is in flight or not */
+    bool bActive;
+
+public:
+    FTPickupIntegrator();
+
+    /** Starts a flight. */
+    void Launch(const FVector& InLocation, const FVector& InVelocity);
+
+    /** Ends the flight right away. */
+    void Stop();
+
+    /** Integrates the fixed steps fitting into a frame. The impact locations
+     *  of the bounces get added to the bounces. */
+    void Advance(const float DeltaSeconds, const float GravityZ,
+                 const float FloorZ, const FVector& Extent,
+                 const TArray<FBox>& Obstacles, TArray<FVector>& Out_Bounces);
+
+    /** Returns whether the item is in flight or not. */
+    FORCEINLINE bool IsActive() const
+    {
+        return bActive;
+    }
+
+    /** Returns the location of the item's center. */
+    FORCEINLINE const FVector& GetLocation() const
+    {
+        return Location;
+    }
+
+    /** Returns the velocity of the item. */
+    FORCEINLINE const FVector& GetVelocity() const
+    {
+        return Velocity;
+    }
+
+private:
+    /** Integrates a single fixed step; returns whether the item touched
+     *  anything or not. */
+    bool Step(const float GravityZ, const float FloorZ, const FVector& Extent,
+              const TArray<FBox>& Obstacles, TArray<FVector>& Out_Bounces);
+
+    /** Reflects the velocity off a face whose normal points along an axis,
+     *  either way (+1 or -1). */
+    void Bounce(const int32 Axis, const float Normal,
+                TArray<FVector>& Out_Bounces);
+};
@@ -0,0 +1,53 @@
+#include "TPickupTrajectory.h"
+#include "HideAndSeekWithAI.h"
+
+/** The colors of the bounces, so each bounce stands out from the previous
+ *  one. */
+static const FColor TRAJECTORY_COLORS[] = {
+    FColor::White,
+    FColor::Black,
+    FColor::Transparent,
+    FColor::Red,
+    FColor::Green,
+    FColor::Blue,
+    FColor::Yellow,
+    FColor::Cyan,
+    FColor::Magenta,
+    FColor::Orange,
+    FColor::Purple,
+    FColor::Turquoise,
+    FColor::Silver,
+    FColor::Emerald
+};
+
+static_assert(UE_ARRAY_COUNT(TRAJECTORY_COLORS) == FTPickupTrajectory::COLORS,
+              "FATAL: the trajectory colors do not match their count!");
+
+FTPickupTrajectory::FTPickupTrajectory()
+    : Head(0),
+      Count(0)
+{
+
+}
+
+const FColor& FTPickupTrajectory::GetColor(const uint8 ColorIndex)
+{
+    return TRAJECTORY_COLORS[ColorIndex % COLORS];
+}
+
+void FTPickupTrajectory::Reset()
+{
+    Head = 0;
+    Count = 0;
+}
+
+void FTPickupTrajectory::Add(const FVector& Location, const float Time,
+                             const uint8 ColorIndex)
+{
+    Locations[Head] = Location;
+    Times[Head] = Time;
+    ColorIndices[Head] = ColorIndex;
+
+    Head = (Head + 1) % CAPACITY;
+    Count = FMath::Min(Count + 1, CAPACITY);
+}
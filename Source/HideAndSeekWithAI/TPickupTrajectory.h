@@ -0,0 +1,83 @@
+#pragma once
+
+#include <CoreTypes.h>
+#include <Math/Color.h>
+#include <Math/Vector.h>
+
+/** The flight of a pickup item, recorded into a fixed-size ring buffer; once
+ *  full, the latest samples overwrite the oldest ones. Each sample keeps the
+ *  location, the world time and the bounce color index of the segment ending
+ *  at it, so recording never allocates. */
+struct HIDEANDSEEKWITHAI_API FTPickupTrajectory
+{
+public:
+    /** The number of samples the ring buffer holds. */
+    static constexpr int32 CAPACITY = 256;
+
+    /** The number of bounce colors. */
+    static constexpr uint8 COLORS = 14;
+
+private:
+    /** The sampled locations */
+    FVector Locations[CAPACITY];
+
+    /** The world time of each sample */
+    float Times[CAPACITY];
+
+    /** The bounce color index of each sample */
+    uint8 ColorIndices[CAPACITY];
+
+    /** Where the next sample goes */
+    int32 Head;
+
+    /** The number of samples recorded */
+    int32 Count;
+
+public:
+    FTPickupTrajectory();
+
+    /** Returns one of the bounce colors. */
+    static const FColor& GetColor(const uint8 ColorIndex);
+
+    /** Forgets all the samples. */
+    void Reset();
+
+    /** Records a sample. */
+    void Add(const FVector& Location, const float Time,
+             const uint8 ColorIndex);
+
+    /** Returns the number of samples recorded. */
+    FORCEINLINE int32 Num() const
+    {
+        return Count;
+    }
+
+    /** Returns the location of a sample; the oldest one comes first. */
+    FORCEINLINE const FVector& GetLocation(const int32 Index) const
+    {
+        return Locations[ToSlot(Index)];
+    }
+
+    /** Returns the world time of a sample; the oldest one comes first. */
+    FORCEINLINE float GetTime(const int32 Index) const
+    {
+        return Times[ToSlot(Index)];
+    }
+
+    /** Returns the bounce color index of a sample; the oldest one comes
+     *  first. */
+    FORCEINLINE uint8 GetColorIndex(const int32 Index) const
+    {
+        return ColorIndices[ToSlot(Index)];
+    }
+
+private:
+    /** Maps a sample index to its slot inside the ring buffer. */
+    FORCEINLINE int32 ToSlot(const int32 Index) const
+    {
+        checkf(Index >= 0 && Index < Count, TEXT("%s"),
+               TEXT("FATAL: trajectory sample index out of range!"));
+
+        return (Head - Count + Index + CAPACITY) % CAPACITY;
+    }
+};
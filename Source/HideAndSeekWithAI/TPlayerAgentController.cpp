@@ -0,0 +1,363 @@
+#include "TPlayerAgentController.h"
+#include "HideAndSeekWithAI.h"
+
+#include <CollisionQueryParams.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+#include <Kismet/GameplayStatics.h>
+#include <Math/UnrealMathUtility.h>
+#include <Misc/CommandLine.h>
+#include <Misc/Parse.h>
+#include <NavigationPath.h>
+#include <NavigationSystem.h>
+#include <Templates/Casts.h>
+
+#include "TAICharacter.h"
+#include "TAIController.h"
+#include "TGameState.h"
+#include "TLog.h"
+#include "TPickup.h"
+#include "TPlayerCharacter.h"
+#include "TWinSpot.h"
+
+static constexpr uint64 TLOG_KEY_PLAYER_AGENT = TLOG_KEY_PLAYER + 50;
+static constexpr uint64 TLOG_KEY_PLAYER_AGENT_PATH = TLOG_KEY_PLAYER_AGENT + 1;
+static constexpr uint64 TLOG_KEY_PLAYER_AGENT_THROW = TLOG_KEY_PLAYER_AGENT_PATH + 1;
+
+ATPlayerAgentController::ATPlayerAgentController(
+        const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    PrimaryActorTick.bCanEverTick = true;
+
+    RandomSeed = 0;
+    AcceptanceRadius = 75.0f;
+    RepathInterval = 0.5f;
+    LookAheadDistance = 250.0f;
+    SightRadiusMargin = 100.0f;
+    PeripheralVisionAngleMargin = 10.0f;
+    PickupDetourDistance = 1500.0f;
+    DistractionThrowOvershoot = 400.0f;
+    TurnRate = 8.0f;
+    MaxMoveAngle = 30.0f;
+    MaxWaitTime = 8.0f;
+
+    WinSpot = nullptr;
+    TargetPickup = nullptr;
+    PathPointIndex = 0;
+    RepathRemainingTime = 0.0f;
+    ChargeRemainingTime = 0.0f;
+    WaitedTime = 0.0f;
+}
+
+void ATPlayerAgentController::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    ATPlayerCharacter* PlayerCharacter = Cast<ATPlayerCharacter>(GetCharacter());
+    if (!PlayerCharacter || !InputEnabled() || !IsGameOnGoing())
+    {
+        return;
+    }
+
+    PlayerCharacter->MoveForward(0.0f);
+    PlayerCharacter->MoveRight(0.0f);
+
+    /* Keep charging the throw until the desired distance is reached. */
+    if (IsThrowingItem())
+    {
+        ChargeRemainingTime -= DeltaSeconds;
+        if (ChargeRemainingTime <= 0.0f)
+        {
+            OnInputLMBReleased();
+        }
+
+        return;
+    }
+
+    UWorld* World = this->GetWorld();
+    ATGameState *GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(World));
+    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
+
+    if (PlayerCharacter->CanPickupItems() && GameState->IsPickupAvailable())
+    {
+        OnInputLMBPressed();
+        TargetPickup = nullptr;
+        RepathRemainingTime = 0.0f;
+    }
+
+    RepathRemainingTime -= DeltaSeconds;
+    if (RepathRemainingTime <= 0.0f || !PathPoints.IsValidIndex(PathPointIndex))
+    {
+        UpdatePath(PlayerCharacter);
+        RepathRemainingTime = RepathInterval;
+    }
+
+    if (!PathPoints.IsValidIndex(PathPointIndex))
+    {
+        return;
+    }
+
+    const FVector PlayerLocation(PlayerCharacter->GetActorLocation());
+    FVector NextPoint(PathPoints[PathPointIndex]);
+    NextPoint.Z = PlayerLocation.Z;
+
+    if (FVector::DistSquared2D(PlayerLocation, NextPoint)
+            <= FMath::Square(AcceptanceRadius))
+    {
+        ++PathPointIndex;
+        return;
+    }
+
+    /* Before stepping forward, make sure no bot is able to see where the
+     * player is heading to. */
+    const FVector LookAheadLocation(
+                PlayerLocation
+                + (NextPoint - PlayerLocation).GetSafeNormal2D()
+                * LookAheadDistance);
+    const ATAICharacter* WatchingBot = FindWatchingBot(LookAheadLocation);
+
+    if (WatchingBot && WatchingBot->GetAIState() != EAIState::Alerted
+            && WaitedTime < MaxWaitTime)
+    {
+        if (PlayerCharacter->HasAnyItems())
+        {
+            ThrowDistraction(PlayerCharacter, WatchingBot);
+        }
+        else
+        {
+            TurnToward(PlayerCharacter, NextPoint, DeltaSeconds);
+        }
+
+        WaitedTime += DeltaSeconds;
+        return;
+    }
+
+    WaitedTime = 0.0f;
+    MoveToward(PlayerCharacter, NextPoint, DeltaSeconds);
+}
+
+void ATPlayerAgentController::BeginPlay()
+{
+    Super::BeginPlay();
+
+    int32 Seed = RandomSeed;
+    FParse::Value(FCommandLine::Get(), TEXT("PlayerAgentSeed="), Seed);
+    RandomStream.Initialize(Seed);
+
+    for (TActorIterator<ATWinSpot> ActorItr(GetWorld()); ActorItr; ++ActorItr)
+    {
+        WinSpot = *ActorItr;
+        break;
+    }
+
+    if (!WinSpot)
+    {
+        TLOG_PLAYER_ERROR(TLOG_KEY_PLAYER_AGENT,
+                          "ERROR: cannot find an instance of win spot in the"
+                          " current level!");
+    }
+}
+
+void ATPlayerAgentController::SetupInputComponent()
+{
+    /* The agent does not listen to any human input; so, skip the bindings. */
+    APlayerController::SetupInputComponent();
+}
+
+void ATPlayerAgentController::UpdatePath(
+        const ATPlayerCharacter* PlayerCharacter)
+{
+    PathPoints.Reset();
+    PathPointIndex = 0;
+
+    const FVector PlayerLocation(PlayerCharacter->GetActorLocation());
+
+    if (!TargetPickup || TargetPickup->IsAttachedToACharacter())
+    {
+        TargetPickup = PlayerCharacter->CanPickupItems()
+                ? FindNearbyPickup(PlayerLocation) : nullptr;
+    }
+
+    FVector Goal;
+    if (TargetPickup)
+    {
+        Goal = TargetPickup->GetActorLocation();
+    }
+    else if (WinSpot)
+    {
+        Goal = WinSpot->GetActorLocation();
+    }
+    else
+    {
+        return;
+    }
+
+    UNavigationPath* Path =
+            UNavigationSystemV1::FindPathToLocationSynchronously(
+                GetWorld(), PlayerLocation, Goal,
+                const_cast<ATPlayerCharacter*>(PlayerCharacter));
+
+    if (Path && Path->IsValid() && Path->PathPoints.Num() > 1)
+    {
+        /* The first path point is where the player is standing right now. */
+        PathPoints.Append(Path->PathPoints.GetData() + 1,
+                          Path->PathPoints.Num() - 1);
+    }
+    else
+    {
+        TLOG_PLAYER_VERBOSE(TLOG_KEY_PLAYER_AGENT_PATH,
+                            "No navigation path; heading straight to the goal!",
+                            Goal);
+
+        PathPoints.Add(Goal);
+    }
+}
+
+ATPickup* ATPlayerAgentController::FindNearbyPickup(
+        const FVector& Location) const
+{
+    ATPickup* NearestPickup = nullptr;
+    float NearestDistanceSquared = FMath::Square(PickupDetourDistance);
+
+    for (TActorIterator<ATPickup> ActorItr(GetWorld()); ActorItr; ++ActorItr)
+    {
+        ATPickup* Pickup = *ActorItr;
+        if (Pickup->IsAttachedToACharacter())
+        {
+            continue;
+        }
+
+        const float DistanceSquared =
+                FVector::DistSquared(Location, Pickup->GetActorLocation());
+        if (DistanceSquared < NearestDistanceSquared)
+        {
+            NearestDistanceSquared = DistanceSquared;
+            NearestPickup = Pickup;
+        }
+    }
+
+    return NearestPickup;
+}
+
+ATAICharacter* ATPlayerAgentController::FindWatchingBot(
+        const FVector& Location) const
+{
+    UWorld* World = this->GetWorld();
+    ATGameState *GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(World));
+    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
+
+    FCollisionQueryParams TraceParams(TEXT("PlayerAgentTrace"), false, GetPawn());
+
+    for (ATAICharacter* Bot : GameState->GetBots())
+    {
+        const ATAIController* BotController =
+                Cast<ATAIController>(Bot->GetController());
+        if (!BotController)
+        {
+            continue;
+        }
+
+        const FVector ViewLocation(Bot->GetPawnViewLocation());
+        const FVector Direction(Location - ViewLocation);
+        const float MaxDistance =
+                BotController->GetSightRadius() + SightRadiusMargin;
+
+        if (Direction.SizeSquared() > FMath::Square(MaxDistance))
+        {
+            continue;
+        }
+
+        const float MaxAngle = FMath::DegreesToRadians(FMath::Min(
+                    BotController->GetPeripheralVisionAngle()
+                    + PeripheralVisionAngleMargin, 180.0f));
+        const float DotProduct = FVector::DotProduct(
+                    Bot->GetViewRotation().Vector(), Direction.GetSafeNormal());
+
+        if (DotProduct < FMath::Cos(MaxAngle))
+        {
+            continue;
+        }
+
+        /* Obstacles hide the player from bots. */
+        TraceParams.ClearIgnoredActors();
+        TraceParams.AddIgnoredActor(GetPawn());
+        TraceParams.AddIgnoredActor(Bot);
+
+        FHitResult HitResult(ForceInit);
+        if (!World->LineTraceSingleByChannel(
+                    HitResult, ViewLocation, Location,
+                    ECollisionChannel::ECC_Visibility, TraceParams))
+        {
+            return Bot;
+        }
+    }
+
+    return nullptr;
+}
+
+void ATPlayerAgentController::MoveToward(
+        ATPlayerCharacter* PlayerCharacter, const FVector& Location,
+        const float DeltaSeconds)
+{
+    if (TurnToward(PlayerCharacter, Location, DeltaSeconds))
+    {
+        PlayerCharacter->MoveForward(1.0f);
+    }
+}
+
+void ATPlayerAgentController::ThrowDistraction(
+        ATPlayerCharacter* PlayerCharacter, const ATAICharacter* Bot)
+{
+    const FVector PlayerLocation(PlayerCharacter->GetActorLocation());
+    const FVector BotLocation(Bot->GetActorLocation());
+    const FVector Away((BotLocation - PlayerLocation).GetSafeNormal2D());
+
+    /* A little randomness keeps the bots from always walking the same way. */
+    const FVector Side(FVector::CrossProduct(Away, FVector::UpVector));
+    const FVector Target(
+                BotLocation + Away * DistractionThrowOvershoot
+                + Side * RandomStream.FRandRange(-DistractionThrowOvershoot,
+                                                 DistractionThrowOvershoot));
+
+    FRotator Rotation(GetControlRotation());
+    Rotation.Yaw = (Target - PlayerLocation).Rotation().Yaw;
+    SetControlRotation(Rotation);
+
+    /* Clamped the same way GetEstimatedThrowingDistance clamps the throw. */
+    const float Distance = FMath::Clamp(
+                FVector::Dist2D(PlayerLocation, Target),
+                MinThrowingDistance, MaxThrowingDistance);
+    ChargeRemainingTime = (Distance / MaxThrowingDistance)
+            * MaxThrowingAccumulationTime;
+
+    TLOG_PLAYER_LOG(TLOG_KEY_PLAYER_AGENT_THROW, "Throwing a distraction!",
+                    Cast<AActor>(Bot), Target, ChargeRemainingTime);
+
+    OnInputLMBPressed();
+}
+
+bool ATPlayerAgentController::TurnToward(
+        const ATPlayerCharacter* PlayerCharacter, const FVector& Location,
+        const float DeltaSeconds)
+{
+    const FVector Direction(
+                (Location - PlayerCharacter->GetActorLocation()).GetSafeNormal2D());
+    if (Direction.IsNearlyZero())
+    {
+        return true;
+    }
+
+    const FRotator Rotation(GetControlRotation());
+    FRotator TargetRotation(Rotation);
+    TargetRotation.Yaw = Direction.Rotation().Yaw;
+
+    SetControlRotation(FMath::RInterpTo(Rotation, TargetRotation,
+                                        DeltaSeconds, TurnRate));
+
+    const float Angle = FMath::Abs(FRotator::NormalizeAxis(
+                                       TargetRotation.Yaw - Rotation.Yaw));
+    return (Angle <= MaxMoveAngle);
+}
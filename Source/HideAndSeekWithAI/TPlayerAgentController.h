@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <Math/RandomStream.h>
+#include <UObject/ObjectMacros.h>
+
+#include "TPlayerController.h"
+
+#include "TPlayerAgentController.generated.h"
+
+class ATAICharacter;
+class ATPickup;
+class ATPlayerCharacter;
+class ATWinSpot;
+
+/** A scripted player controller which plays the game on its own instead of
+ *  reading the input bindings. It drives the player character through the
+ *  very same code paths a human player uses, which makes it suitable for
+ *  automated play, soak tests and headless benchmarks. */
+UCLASS(BlueprintType, config=Game)
+class HIDEANDSEEKWITHAI_API ATPlayerAgentController : public ATPlayerController
+{
+    GENERATED_UCLASS_BODY()
+
+protected:
+    /** The seed used for all the random decisions of the agent; the same seed
+     *  and layout lead to the same decisions. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    int32 RandomSeed;
+
+    /** The distance at which a path point counts as reached. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float AcceptanceRadius;
+
+    /** Seconds between two consecutive path queries. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float RepathInterval;
+
+    /** How far ahead of the player character along the path the agent checks
+     *  for bots' field of views. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float LookAheadDistance;
+
+    /** Extra distance added to the bots' sight radius in order to keep a safe
+     *  margin. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float SightRadiusMargin;
+
+    /** Extra angle in degrees added to the bots' peripheral vision angle in
+     *  order to keep a safe margin. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float PeripheralVisionAngleMargin;
+
+    /** Maximum distance the agent is willing to go off its way in order to
+     *  pick up an item. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float PickupDetourDistance;
+
+    /** The distraction throws land this far behind the bot, so the bot walks
+     *  away from the player to investigate. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float DistractionThrowOvershoot;
+
+    /** The turn rate used to face the next path point. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float TurnRate;
+
+    /** The maximum angle in degrees between the player's facing and the
+     *  next path point for the agent to move forward. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float MaxMoveAngle;
+
+    /** Maximum seconds the agent hides from a bot before taking the risk and
+     *  moving on. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Agent")
+    float MaxWaitTime;
+
+private:
+    /** The random stream all the random decisions are taken from. */
+    FRandomStream RandomStream;
+
+    /** The win spot of the current level. */
+    UPROPERTY(Transient)
+    ATWinSpot* WinSpot;
+
+    /** The pickup item the agent is heading to, if any. */
+    UPROPERTY(Transient)
+    ATPickup* TargetPickup;
+
+    /** The current path the agent is following. */
+    UPROPERTY(Transient)
+    TArray<FVector> PathPoints;
+
+    /** The index of the path point the agent is heading to. */
+    UPROPERTY(Transient)
+    int32 PathPointIndex;
+
+    /** Seconds left until the next path query. */
+    UPROPERTY(Transient)
+    float RepathRemainingTime;
+
+    /** Seconds left until the agent releases the throw button. */
+    UPROPERTY(Transient)
+    float ChargeRemainingTime;
+
+    /** Seconds the agent has been hiding from bots so far. */
+    UPROPERTY(Transient)
+    float WaitedTime;
+
+public:
+    virtual void Tick(float DeltaSeconds) override;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void SetupInputComponent() override;
+
+private:
+    /** Finds the path to the current goal, a nearby pickup item or the win
+     *  spot. */
+    void UpdatePath(const ATPlayerCharacter* PlayerCharacter);
+
+    /** Returns the nearest free pickup item within the detour distance. */
+    ATPickup* FindNearbyPickup(const FVector& Location) const;
+
+    /** Returns the first bot which is able to see the location, or nullptr if
+     *  the location is hidden from all bots. */
+    ATAICharacter* FindWatchingBot(const FVector& Location) const;
+
+    /** Turns the player toward a location and moves forward once facing it. */
+    void MoveToward(ATPlayerCharacter* PlayerCharacter, const FVector& Location,
+                    const float DeltaSeconds);
+
+    /** Turns the player toward the location behind the bot and starts
+     *  charging a throw long enough to reach there. */
+    void ThrowDistraction(ATPlayerCharacter* PlayerCharacter,
+                          const ATAICharacter* Bot);
+
+    /** Turns the player's control rotation toward a location. */
+    bool TurnToward(const ATPlayerCharacter* PlayerCharacter,
+                    const FVector& Location, const float DeltaSeconds);
+};
@@ -118,7 +118,7 @@ void ATPlayerCharacter::ThrowItem(const FVector& Impulse)
     if (HasAnyItems())
     {
         Item->DetachFromCharacter(this);
-        Item->GetMesh()->AddImpulse(Impulse, NAME_None, true);
+        Item->Launch(Impulse);
         Item = nullptr;
     }
 }
@@ -1,6 +1,11 @@
 #include "TPlayerController.h"
 #include "HideAndSeekWithAI.h"
 
+#include <Components/CapsuleComponent.h>
+#include <Components/StaticMeshComponent.h>
+#include <Engine/StaticMesh.h>
+#include <Engine/World.h>
+#include <HAL/IConsoleManager.h>
 #include <Kismet/GameplayStatics.h>
 #include <Templates/Casts.h>
 
@@ -9,6 +14,17 @@
 #include "TPickup.h"
 #include "TPlayerCharacter.h"
 
+/** The color of the throw preview. */
+static const FColor THROW_PREVIEW_COLOR(FColor::Cyan);
+
+static TAutoConsoleVariable<int32> CVarThrowPreview(
+        TEXT("t.Throw.Preview"),
+        1,
+        TEXT("Shows where the item lands while the throw charges.\n"
+             " 0: off\n"
+             " 1: on"),
+        ECVF_Default);
+
 ATPlayerController::ATPlayerController(
         const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -17,6 +33,9 @@ ATPlayerController::ATPlayerController(
     MinThrowingDistance = 100.0f;
     MaxThrowingDistance = 1500.0f;
     ThrowingArc = 0.75;
+
+    ThrowPreviewFloorZ = 0.0f;
+    ThrowPreviewItemExtent = FVector::ZeroVector;
 }
 
 void ATPlayerController::Tick(float DeltaSeconds)
@@ -26,6 +45,8 @@ void ATPlayerController::Tick(float DeltaSeconds)
     if (bIsThrowingItem)
     {
         ThrowingAccumulatedTime += DeltaSeconds;
+
+        UpdateThrowPreview();
     }
 }
 
@@ -94,6 +115,8 @@ void ATPlayerController::OnInputLMBPressed()
         {
             ThrowingAccumulatedTime = 0.0f;
             bIsThrowingItem = true;
+
+            BeginThrowPreview();
         }
 
         return;
@@ -124,6 +147,8 @@ void ATPlayerController::OnInputLMBReleased()
 
         ThrowingAccumulatedTime = 0.0f;
         bIsThrowingItem = false;
+
+        ThrowPreview.Reset();
     }
 }
 
@@ -170,6 +195,63 @@ bool ATPlayerController::IsGameOnGoing() const
     return GameState->IsGameOnGoing();
 }
 
+void ATPlayerController::BeginThrowPreview()
+{
+    ThrowPreview.Reset();
+
+    ATPlayerCharacter* PlayerCharacter = Cast<ATPlayerCharacter>(GetCharacter());
+    checkf(PlayerCharacter, TEXT("FATAL: no player character is assigned!"));
+
+    /* The player stands on the floor for the whole throw. */
+    ThrowPreviewFloorZ = PlayerCharacter->GetActorLocation().Z
+            - PlayerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+    /* The carried item keeps its default scale while held; the default object
+     * spares querying the bounds of the attached mesh. */
+    ThrowPreviewItemExtent = FVector::ZeroVector;
+
+    const ATPickup* Item = PlayerCharacter->GetCarryingItem();
+    if (Item)
+    {
+        const UStaticMeshComponent* DefaultMesh =
+                Item->GetClass()->GetDefaultObject<ATPickup>()->GetMesh();
+        const UStaticMesh* StaticMesh = DefaultMesh->GetStaticMesh();
+
+        if (StaticMesh)
+        {
+            ThrowPreviewItemExtent = StaticMesh->GetBounds().BoxExtent
+                    * DefaultMesh->GetRelativeScale3D();
+        }
+    }
+}
+
+void ATPlayerController::UpdateThrowPreview()
+{
+    if (CVarThrowPreview.GetValueOnGameThread() == 0)
+    {
+        return;
+    }
+
+    ATPlayerCharacter* PlayerCharacter = Cast<ATPlayerCharacter>(GetCharacter());
+    checkf(PlayerCharacter, TEXT("FATAL: no player character is assigned!"));
+
+    const ATPickup* Item = PlayerCharacter->GetCarryingItem();
+    if (!Item)
+    {
+        return;
+    }
+
+    UWorld* World = this->GetWorld();
+    const ATGameState* GameState = Cast<ATGameState>(
+                UGameplayStatics::GetGameState(World));
+    checkf(GameState, TEXT("FATAL: not HideAndSeekWithAI's game state!"));
+
+    ThrowPreview.Update(Item->GetActorLocation(), SuggestThrowingLaunchImpulse(),
+                        World->GetGravityZ(), ThrowPreviewFloorZ,
+                        ThrowPreviewItemExtent, GameState->GetObstacleBounds());
+    ThrowPreview.Draw(World, THROW_PREVIEW_COLOR);
+}
+
 FVector ATPlayerController::SuggestThrowingLaunchImpulse() const
 {
     FVector LaunchImpulse(FVector::ZeroVector);
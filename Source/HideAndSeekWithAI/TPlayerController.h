@@ -5,6 +5,8 @@
 #include <Math/UnrealMathUtility.h>
 #include <UObject/ObjectMacros.h>
 
+#include "TThrowPreview.h"
+
 #include "TPlayerController.generated.h"
 
 /** The player's controller class. */
@@ -43,6 +45,15 @@ private:
     UPROPERTY(Transient)
     float ThrowingAccumulatedTime;
 
+    /** Shows the player where the item lands while the throw charges. */
+    FTThrowPreview ThrowPreview;
+
+    /** The floor height under the player when the throw started charging. */
+    float ThrowPreviewFloorZ;
+
+    /** The extent of the item being thrown. */
+    FVector ThrowPreviewItemExtent;
+
 public:
     virtual void Tick(float DeltaSeconds) override;
 
@@ -98,10 +109,15 @@ public:
 protected:
     virtual void SetupInputComponent() override;
 
-private:
     /** Determines whether the game is ongoing or it has been ended? */
     bool IsGameOnGoing() const;
 
+    /** Starts previewing the throw of the carried item. */
+    void BeginThrowPreview();
+
+    /** Updates and draws the throw preview for the current frame. */
+    void UpdateThrowPreview();
+
     /** Calculations for the best launch velocity in order to land the item
      *  projectile based on the input from the player (the amount of time the
      *  player holds down the throw item button). */
@@ -0,0 +1,95 @@
+#include "TStats.h"
+
+DEFINE_STAT(STAT_HideAndSeek_AIControllerTick);
+DEFINE_STAT(STAT_HideAndSeek_OnTargetPerceptionUpdated);
+DEFINE_STAT(STAT_HideAndSeek_OnPerceptionUpdated);
+DEFINE_STAT(STAT_HideAndSeek_IsPlayerInSight);
+DEFINE_STAT(STAT_HideAndSeek_MoveToTargetLocation);
+DEFINE_STAT(STAT_HideAndSeek_DrawFOV);
+DEFINE_STAT(STAT_HideAndSeek_NoisePropagation);
+
+DEFINE_STAT(STAT_HideAndSeek_IdleTick);
+DEFINE_STAT(STAT_HideAndSeek_SuspiciousTick);
+DEFINE_STAT(STAT_HideAndSeek_AlertedTick);
+DEFINE_STAT(STAT_HideAndSeek_InvestigationTick);
+DEFINE_STAT(STAT_HideAndSeek_CarryingItemTick);
+DEFINE_STAT(STAT_HideAndSeek_GoingBackTick);
+
+DEFINE_STAT(STAT_HideAndSeek_SpawnObstacles);
+DEFINE_STAT(STAT_HideAndSeek_SpawnPickups);
+DEFINE_STAT(STAT_HideAndSeek_SpawnBots);
+DEFINE_STAT(STAT_HideAndSeek_PickupNotifyHit);
+DEFINE_STAT(STAT_HideAndSeek_TrajectoryRenderer);
+
+DEFINE_STAT(STAT_HideAndSeek_AIStateOverlay);
+
+DEFINE_STAT(STAT_HideAndSeek_TLogEmit);
+
+DEFINE_STAT(STAT_HideAndSeek_BotsIdle);
+DEFINE_STAT(STAT_HideAndSeek_BotsSuspicious);
+DEFINE_STAT(STAT_HideAndSeek_BotsAlerted);
+DEFINE_STAT(STAT_HideAndSeek_BotsInvestigating);
+DEFINE_STAT(STAT_HideAndSeek_BotsCarryingItem);
+DEFINE_STAT(STAT_HideAndSeek_BotsGoingBack);
+
+FTFrameCounters FTStats::FrameCounters;
+FTFrameCounters FTStats::LastFrameCounters;
+int32 FTStats::BotsInAIState[static_cast<uint8>(EAIState::GoingBack) + 1] = { };
+int32 FTStats::AIScopeDepth = 0;
+int32 FTStats::PerceptionScopeDepth = 0;
+double FTStats::LastLayoutSpawnTime = 0.0;
+double FTStats::RestartRequestTime = 0.0;
+double FTStats::LastRestartLatency = 0.0;
+FSimpleMulticastDelegate FTStats::OnFrameEnded;
+
+FTFrameCounters::FTFrameCounters()
+    : AICycles(0),
+      PerceptionCycles(0),
+      PathRequests(0),
+      SightChecks(0),
+      NoiseEvents(0)
+{
+
+}
+
+void FTStats::AddBotsInAIState(const EAIState& State, const int32 Amount)
+{
+    BotsInAIState[static_cast<uint8>(State)] += Amount;
+
+    switch (State)
+    {
+    case EAIState::Idle:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsIdle, Amount);
+        break;
+    case EAIState::Suspicious:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsSuspicious, Amount);
+        break;
+    case EAIState::Alerted:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsAlerted, Amount);
+        break;
+    case EAIState::Investigating:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsInvestigating, Amount);
+        break;
+    case EAIState::CarryingItem:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsCarryingItem, Amount);
+        break;
+    case EAIState::GoingBack:
+        INC_DWORD_STAT_BY(STAT_HideAndSeek_BotsGoingBack, Amount);
+        break;
+    }
+}
+
+int32 FTStats::GetBotsInAIState(const EAIState& State)
+{
+    return BotsInAIState[static_cast<uint8>(State)];
+}
+
+void FTStats::EndFrame()
+{
+    check(IsInGameThread());
+
+    LastFrameCounters = FrameCounters;
+    FrameCounters = FTFrameCounters();
+
+    OnFrameEnded.Broadcast();
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <CoreTypes.h>
+#include <Delegates/Delegate.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/CoreMiscDefines.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+#include <Stats/Stats.h>
+
+#include "HideAndSeekWithAI.h"
+
+DECLARE_STATS_GROUP(TEXT("HideAndSeek"), STATGROUP_HideAndSeek, STATCAT_Advanced);
+
+/* AI */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Controller Tick"), STAT_HideAndSeek_AIControllerTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnTargetPerceptionUpdated"), STAT_HideAndSeek_OnTargetPerceptionUpdated, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnPerceptionUpdated"), STAT_HideAndSeek_OnPerceptionUpdated, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IsPlayerInSight"), STAT_HideAndSeek_IsPlayerInSight, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("MoveToTargetLocation"), STAT_HideAndSeek_MoveToTargetLocation, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DrawFOV"), STAT_HideAndSeek_DrawFOV, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Noise Propagation"), STAT_HideAndSeek_NoisePropagation, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/* AI state ticks */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Idle Tick"), STAT_HideAndSeek_IdleTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Suspicious Tick"), STAT_HideAndSeek_SuspiciousTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Alerted Tick"), STAT_HideAndSeek_AlertedTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Investigation Tick"), STAT_HideAndSeek_InvestigationTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Carrying Item Tick"), STAT_HideAndSeek_CarryingItemTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Going Back Tick"), STAT_HideAndSeek_GoingBackTick, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/* Gameplay */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Obstacles"), STAT_HideAndSeek_SpawnObstacles, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Pickups"), STAT_HideAndSeek_SpawnPickups, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Bots"), STAT_HideAndSeek_SpawnBots, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pickup NotifyHit"), STAT_HideAndSeek_PickupNotifyHit, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trajectory Renderer"), STAT_HideAndSeek_TrajectoryRenderer, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/* UI */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI State Overlay"), STAT_HideAndSeek_AIStateOverlay, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/* Logging */
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TLog Emit"), STAT_HideAndSeek_TLogEmit, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/* Bots per AI state */
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Idle"), STAT_HideAndSeek_BotsIdle, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Suspicious"), STAT_HideAndSeek_BotsSuspicious, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Alerted"), STAT_HideAndSeek_BotsAlerted, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Investigating"), STAT_HideAndSeek_BotsInvestigating, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Carrying Item"), STAT_HideAndSeek_BotsCarryingItem, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bots Going Back"), STAT_HideAndSeek_BotsGoingBack, STATGROUP_HideAndSeek, HIDEANDSEEKWITHAI_API);
+
+/** Measures the enclosing scope. The cycle counters show up in the call
+ *  counts and timings of 'stat HideAndSeek', and in Unreal Insights when the
+ *  game runs with '-statnamedevents'. Builds without stats still report the
+ *  scope to Unreal Insights through the CPU profiler trace channel. */
+#if STATS
+#define TSTAT_SCOPE( Stat )  \
+    SCOPE_CYCLE_COUNTER( Stat )
+#else
+#define TSTAT_SCOPE( Stat )  \
+    TRACE_CPUPROFILER_EVENT_SCOPE( Stat )
+#endif  /* STATS */
+
+/** Frame counters are cheap, always-on counters gathered on the game thread
+ *  and rolled over at the end of every frame, so the automated benchmarks and
+ *  the match profiler can sample the latest complete frame. */
+#define TSTAT_FRAME_COUNTERS  ( !UE_BUILD_SHIPPING )
+
+/** The counters gathered during a single frame. */
+struct HIDEANDSEEKWITHAI_API FTFrameCounters
+{
+    /** Game thread cycles spent inside the AI controllers. */
+    uint64 AICycles;
+
+    /** Game thread cycles spent inside the perception callbacks and the noise
+     *  propagation. */
+    uint64 PerceptionCycles;
+
+    /** Number of move requests issued by the bots. */
+    int32 PathRequests;
+
+    /** Number of player in sight checks. */
+    int32 SightChecks;
+
+    /** Number of noise events reported by the thrown items. */
+    int32 NoiseEvents;
+
+    FTFrameCounters();
+};
+
+/** Accumulates the cycles of the outermost scope only, so nested instrumented
+ *  functions are not counted twice. */
+class HIDEANDSEEKWITHAI_API FTCycleCounterScope
+{
+public:
+    FORCEINLINE FTCycleCounterScope(uint64& InCycles, int32& InDepth)
+        : Cycles(InCycles),
+          Depth(InDepth),
+          StartCycles(Depth++ == 0 ? FPlatformTime::Cycles64() : 0)
+    {
+
+    }
+
+    FORCEINLINE ~FTCycleCounterScope()
+    {
+        if (--Depth == 0)
+        {
+            Cycles += FPlatformTime::Cycles64() - StartCycles;
+        }
+    }
+
+private:
+    uint64& Cycles;
+    int32& Depth;
+    const uint64 StartCycles;
+};
+
+/** Helpers for the stats that cannot be updated through a single macro. */
+struct HIDEANDSEEKWITHAI_API FTStats
+{
+    /** The counters of the current frame. */
+    static FTFrameCounters FrameCounters;
+
+    /** The counters of the latest complete frame. */
+    static FTFrameCounters LastFrameCounters;
+
+    /** Number of bots in each AI state. */
+    static int32 BotsInAIState[static_cast<uint8>(EAIState::GoingBack) + 1];
+
+    /** Nesting depth of the AI scopes. */
+    static int32 AIScopeDepth;
+
+    /** Nesting depth of the perception scopes. */
+    static int32 PerceptionScopeDepth;
+
+    /** Seconds spent on spawning the latest level layout. */
+    static double LastLayoutSpawnTime;
+
+    /** The time a level restart has been requested, or zero. */
+    static double RestartRequestTime;
+
+    /** Seconds between the latest level restart request and the new layout
+     *  being ready. */
+    static double LastRestartLatency;
+
+    /** Gets broadcast once the frame counters have been rolled over, so
+     *  LastFrameCounters holds the frame that just ended. FCoreDelegates'
+     *  OnEndFrame runs its handlers in reverse order, so the ones that read
+     *  the counters have to hook in here instead. */
+    static FSimpleMulticastDelegate OnFrameEnded;
+
+    /** Adds to (or subtracts from) the number of bots in an AI state. */
+    static void AddBotsInAIState(const EAIState& State, const int32 Amount);
+
+    /** Returns the number of bots in an AI state. */
+    static int32 GetBotsInAIState(const EAIState& State);
+
+    /** Rolls the current frame counters over and broadcasts OnFrameEnded;
+     *  called at the end of every frame. */
+    static void EndFrame();
+};
+
+#if TSTAT_FRAME_COUNTERS
+/** Measures the enclosing AI scope and adds it to the AI frame time. */
+#define TSTAT_AI_SCOPE( Stat )  \
+    TSTAT_SCOPE( Stat );  \
+    const FTCycleCounterScope ANONYMOUS_VARIABLE( TStatAIScope_ )(  \
+            FTStats::FrameCounters.AICycles, FTStats::AIScopeDepth )
+
+/** Measures the enclosing perception scope and adds it to both the AI and the
+ *  perception frame times. */
+#define TSTAT_PERCEPTION_SCOPE( Stat )  \
+    TSTAT_AI_SCOPE( Stat );  \
+    const FTCycleCounterScope ANONYMOUS_VARIABLE( TStatPerceptionScope_ )(  \
+            FTStats::FrameCounters.PerceptionCycles,  \
+            FTStats::PerceptionScopeDepth )
+
+/** Increments one of the frame counters. */
+#define TSTAT_INC_FRAME_COUNTER( Counter )  \
+    ++FTStats::FrameCounters.Counter
+#else
+#define TSTAT_AI_SCOPE( Stat )  \
+    TSTAT_SCOPE( Stat )
+#define TSTAT_PERCEPTION_SCOPE( Stat )  \
+    TSTAT_SCOPE( Stat )
+#define TSTAT_INC_FRAME_COUNTER( Counter )
+#endif  /* TSTAT_FRAME_COUNTERS */
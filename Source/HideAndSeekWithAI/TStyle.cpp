@@ -0,0 +1,80 @@
+#include "TStyle.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Math/Color.h>
+#include <Math/Vector2D.h>
+#include <Styling/SlateStyleRegistry.h>
+#include <Styling/SlateTypes.h>
+
+const FName FTStyle::FONT_BOLD_40(TEXT("Font.Bold.40"));
+const FName FTStyle::FONT_BOLD_50(TEXT("Font.Bold.50"));
+const FName FTStyle::GAME_MESSAGE(TEXT("Text.GameMessage"));
+const FName FTStyle::AI_STATE_MARKER(TEXT("Text.AIStateMarker"));
+
+TSharedPtr<FSlateStyleSet> FTStyle::StyleSet;
+
+void FTStyle::Initialize()
+{
+    if (StyleSet.IsValid())
+    {
+        return;
+    }
+
+    StyleSet = Create();
+    FSlateStyleRegistry::RegisterSlateStyle(*StyleSet);
+}
+
+void FTStyle::Shutdown()
+{
+    if (!StyleSet.IsValid())
+    {
+        return;
+    }
+
+    FSlateStyleRegistry::UnRegisterSlateStyle(*StyleSet);
+    checkf(StyleSet.IsUnique(),
+           TEXT("FATAL: the style set is still referenced on shutdown!"));
+    StyleSet.Reset();
+}
+
+const ISlateStyle& FTStyle::Get()
+{
+    checkf(StyleSet.IsValid(),
+           TEXT("FATAL: the style set is used before the game module"
+                " starts!"));
+
+    return *StyleSet;
+}
+
+FName FTStyle::GetStyleSetName()
+{
+    static const FName StyleSetName(TEXT("HideAndSeekWithAIStyle"));
+    return StyleSetName;
+}
+
+TSharedRef<FSlateStyleSet> FTStyle::Create()
+{
+    TSharedRef<FSlateStyleSet> Style =
+            MakeShareable(new FSlateStyleSet(GetStyleSetName()));
+
+    const FSlateFontInfo Bold40 = TTF_FONT("LiberationSans-Bold", 40);
+    const FSlateFontInfo Bold50 = TTF_FONT("LiberationSans-Bold", 50);
+
+    Style->Set(FONT_BOLD_40, Bold40);
+    Style->Set(FONT_BOLD_50, Bold50);
+
+    Style->Set(GAME_MESSAGE,
+               FTextBlockStyle()
+               .SetFont(Bold40)
+               .SetColorAndOpacity(FLinearColor::Yellow));
+
+    /* The markers get their colors from the HUD, per AI state. */
+    Style->Set(AI_STATE_MARKER,
+               FTextBlockStyle()
+               .SetFont(Bold50)
+               .SetColorAndOpacity(FLinearColor::White)
+               .SetShadowOffset(FVector2D(1.0f, 1.0f))
+               .SetShadowColorAndOpacity(FLinearColor(0.0f, 0.0f, 0.0f, 0.2f)));
+
+    return Style;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <CoreTypes.h>
+#include <Styling/ISlateStyle.h>
+#include <Styling/SlateStyle.h>
+#include <Templates/SharedPointer.h>
+#include <UObject/NameTypes.h>
+
+/** The game's Slate style set holding its fonts and text styles. It gets
+ *  created and registered once the game module starts and stays alive until
+ *  the module shuts down; so, widgets refer to the styles by name and never
+ *  allocate their own, no matter how many times they get rebuilt. */
+class HIDEANDSEEKWITHAI_API FTStyle
+{
+public:
+    /** The bold font, in all the sizes the game uses. */
+    static const FName FONT_BOLD_40;
+    static const FName FONT_BOLD_50;
+
+    /** The text style of the match results and the game messages. */
+    static const FName GAME_MESSAGE;
+
+    /** The text style of the AI state markers above the bots. */
+    static const FName AI_STATE_MARKER;
+
+private:
+    /** The registered style set, if any. */
+    static TSharedPtr<FSlateStyleSet> StyleSet;
+
+public:
+    /** Creates and registers the style set; gets called once the game module
+     *  starts. */
+    static void Initialize();
+
+    /** Unregisters and destroys the style set; gets called once the game
+     *  module shuts down. */
+    static void Shutdown();
+
+    /** Returns the style set. */
+    static const ISlateStyle& Get();
+
+    /** Returns the name the style set is registered with. */
+    static FName GetStyleSetName();
+
+private:
+    /** Creates the style set. */
+    static TSharedRef<FSlateStyleSet> Create();
+};
@@ -4,42 +4,146 @@
 #include <GameFramework/Actor.h>
 #include <Templates/Casts.h>
 
-static constexpr uint8 NEUTRAL_TEAM_NUMBER = 255;
+#include "TLog.h"
+#include "TTeamSettings.h"
 
-bool UTTeamComponent::IsNeutral(AActor* Actor)
+static constexpr uint64 TLOG_KEY_TEAM_ATTITUDES = TLOG_KEY_GENERIC + 5000;
+
+uint64 UTTeamComponent::HostileMasks[MAX_TEAMS] = {};
+uint64 UTTeamComponent::FriendlyMasks[MAX_TEAMS] = {};
+
+void UTTeamComponent::LoadAttitudes(const UTTeamSettings& Settings)
+{
+    const uint64 AllTeams = ~uint64(0);
+
+    for (uint8 Team = 0; Team < MAX_TEAMS; ++Team)
+    {
+        const uint64 OtherTeams = AllTeams & ~GetTeamMask(Team);
+
+        HostileMasks[Team] = Settings.DefaultAttitude == ETeamAttitude::Hostile
+                ? OtherTeams : 0;
+        FriendlyMasks[Team] = Settings.DefaultAttitude == ETeamAttitude::Friendly
+                ? OtherTeams : 0;
+    }
+
+    for (const FTTeamRelation& Relation : Settings.Relations)
+    {
+        if (IsNeutral(Relation.TeamA) || IsNeutral(Relation.TeamB)
+                || Relation.TeamA == Relation.TeamB)
+        {
+            TLOG_WARNING(TLOG_KEY_TEAM_ATTITUDES,
+                         "WARNING: ignoring an invalid team relation!",
+                         Relation.TeamA, Relation.TeamB);
+            continue;
+        }
+
+        const uint64 BitA = GetTeamMask(Relation.TeamA);
+        const uint64 BitB = GetTeamMask(Relation.TeamB);
+
+        HostileMasks[Relation.TeamA] &= ~BitB;
+        HostileMasks[Relation.TeamB] &= ~BitA;
+        FriendlyMasks[Relation.TeamA] &= ~BitB;
+        FriendlyMasks[Relation.TeamB] &= ~BitA;
+
+        if (Relation.Attitude == ETeamAttitude::Hostile)
+        {
+            HostileMasks[Relation.TeamA] |= BitB;
+            HostileMasks[Relation.TeamB] |= BitA;
+        }
+        else if (Relation.Attitude == ETeamAttitude::Friendly)
+        {
+            FriendlyMasks[Relation.TeamA] |= BitB;
+            FriendlyMasks[Relation.TeamB] |= BitA;
+        }
+    }
+}
+
+ETeamAttitude::Type UTTeamComponent::GetAttitude(const FGenericTeamId TeamA,
+                                                 const FGenericTeamId TeamB)
+{
+    if (IsNeutral(TeamA.GetId()) || IsNeutral(TeamB.GetId()))
+    {
+        return ETeamAttitude::Neutral;
+    }
+
+    if (AreEnemies(TeamA.GetId(), TeamB.GetId()))
+    {
+        return ETeamAttitude::Hostile;
+    }
+
+    if (AreFriendly(TeamA.GetId(), TeamB.GetId()))
+    {
+        return ETeamAttitude::Friendly;
+    }
+
+    return ETeamAttitude::Neutral;
+}
+
+uint8 UTTeamComponent::GetTeamNumber(const AActor* Actor)
 {
     checkf(Actor, TEXT("%s"), TEXT("FATAL: Actor is NULL!"));
 
-    UTTeamComponent* TeamComponent = Cast<UTTeamComponent>(
+    if (const IGenericTeamAgentInterface* TeamAgent =
+            Cast<const IGenericTeamAgentInterface>(Actor))
+    {
+        return TeamAgent->GetGenericTeamId().GetId();
+    }
+
+    const UTTeamComponent* TeamComponent = Cast<UTTeamComponent>(
                 Actor->GetComponentByClass(UTTeamComponent::StaticClass()));
 
     if (!TeamComponent)
     {
-        return true;
+        return NEUTRAL_TEAM_NUMBER;
     }
 
-    return TeamComponent->TeamNumber == NEUTRAL_TEAM_NUMBER;
+    return TeamComponent->TeamNumber;
 }
 
-bool UTTeamComponent::AreFriendly(AActor* ActorA, AActor* ActorB)
+void UTTeamComponent::FilterHostiles(const uint8 Team,
+                                     const TArrayView<const uint8>& Teams,
+                                     TArray<int32>& Out_Indices)
 {
-    checkf(ActorA, TEXT("%s"), TEXT("FATAL: Actor A is NULL!"));
-    checkf(ActorB, TEXT("%s"), TEXT("FATAL: Actor B is NULL!"));
+    const uint64 HostileMask = GetHostileMask(Team);
 
-    checkf(ActorA != ActorB, TEXT("%s"),
-           TEXT("FATAL: Actor A and B are the same!"));
+    for (int32 Index = 0; Index < Teams.Num(); ++Index)
+    {
+        if (HostileMask & GetTeamMask(Teams[Index]))
+        {
+            Out_Indices.Add(Index);
+        }
+    }
+}
 
-    UTTeamComponent* TeamComponentA = Cast<UTTeamComponent>(
-                ActorA->GetComponentByClass(UTTeamComponent::StaticClass()));
-    UTTeamComponent* TeamComponentB = Cast<UTTeamComponent>(
-                ActorB->GetComponentByClass(UTTeamComponent::StaticClass()));
+void UTTeamComponent::FilterHostiles(const uint8 Team,
+                                     const TArrayView<AActor* const>& Actors,
+                                     TArray<AActor*>& Out_Hostiles)
+{
+    const uint64 HostileMask = GetHostileMask(Team);
 
-    if (!TeamComponentA || !TeamComponentB)
+    for (AActor* Actor : Actors)
     {
-        return true;
+        if (HostileMask & GetTeamMask(GetTeamNumber(Actor)))
+        {
+            Out_Hostiles.Add(Actor);
+        }
     }
+}
 
-    return TeamComponentA->TeamNumber == TeamComponentB->TeamNumber;
+bool UTTeamComponent::IsNeutral(const AActor* Actor)
+{
+    return IsNeutral(GetTeamNumber(Actor));
+}
+
+bool UTTeamComponent::AreFriendly(const AActor* ActorA, const AActor* ActorB)
+{
+    checkf(ActorA, TEXT("%s"), TEXT("FATAL: Actor A is NULL!"));
+    checkf(ActorB, TEXT("%s"), TEXT("FATAL: Actor B is NULL!"));
+
+    checkf(ActorA != ActorB, TEXT("%s"),
+           TEXT("FATAL: Actor A and B are the same!"));
+
+    return AreFriendly(GetTeamNumber(ActorA), GetTeamNumber(ActorB));
 }
 
 UTTeamComponent::UTTeamComponent(
@@ -51,3 +155,15 @@ UTTeamComponent::UTTeamComponent(
     TeamNumber = NEUTRAL_TEAM_NUMBER;
     TeamColor = FColor::White;
 }
+
+void UTTeamComponent::SetTeamNumber(const uint8 Number)
+{
+    TeamNumber = Number;
+
+    IGenericTeamAgentInterface* TeamAgent =
+            Cast<IGenericTeamAgentInterface>(GetOwner());
+    if (TeamAgent && TeamAgent->GetGenericTeamId().GetId() != Number)
+    {
+        TeamAgent->SetGenericTeamId(FGenericTeamId(Number));
+    }
+}
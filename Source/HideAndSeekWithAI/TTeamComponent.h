@@ -1,30 +1,122 @@
 #pragma once
 
 #include <Components/ActorComponent.h>
+#include <Containers/Array.h>
+#include <Containers/ArrayView.h>
 #include <CoreTypes.h>
+#include <GenericTeamAgentInterface.h>
 #include <Math/Color.h>
 #include <UObject/ObjectMacros.h>
 
 #include "TTeamComponent.generated.h"
 
-/** The team component in order to detect enemies, friendlies, or neutrals. */
+class UTTeamSettings;
+
+/** The team component in order to detect enemies, friendlies, or neutrals.
+ *  Owners implementing IGenericTeamAgentInterface, e.g. ATCharacter, cache
+ *  the team number as their generic team id; so, the team queries on them are
+ *  plain byte comparisons and the perception system is able to filter by
+ *  affiliation on its own.
+ *
+ *  The attitudes between the teams come from UTTeamSettings. Each team keeps
+ *  the set of teams hostile and friendly to it as a bitmask; so, each query is
+ *  a single AND, and so is each actor of a batched query. */
 UCLASS(ClassGroup=(HIDEANDSEEKWITHAI), meta=(BlueprintSpawnableComponent))
 class HIDEANDSEEKWITHAI_API UTTeamComponent : public UActorComponent
 {
     GENERATED_UCLASS_BODY()
 
 public:
+    /** The number of teams the attitude matrix holds; the team numbers from
+     *  here on have no team. */
+    static constexpr uint8 MAX_TEAMS = 64;
+
+    /** The team number of the actors without any team; the same as
+     *  FGenericTeamId::NoTeam. */
+    static constexpr uint8 NEUTRAL_TEAM_NUMBER = 255;
+
+private:
+    /** The teams each team is hostile to, one bit per team. */
+    static uint64 HostileMasks[MAX_TEAMS];
+
+    /** The teams each team is friendly to, one bit per team. */
+    static uint64 FriendlyMasks[MAX_TEAMS];
+
+public:
+    /** Builds the attitude bitmasks out of the team settings. */
+    static void LoadAttitudes(const UTTeamSettings& Settings);
+
+    /** Returns the attitude of team A towards team B; also serves as the
+     *  attitude solver of the generic team ids. */
+    static ETeamAttitude::Type GetAttitude(const FGenericTeamId TeamA,
+                                           const FGenericTeamId TeamB);
+
+    /** Returns the team number of an actor. Team agents answer right away;
+     *  the component of any other actor gets looked up. Actors without a team
+     *  component are neutral. */
+    static uint8 GetTeamNumber(const AActor* Actor);
+
+    /** Returns the bit of a team in the attitude bitmasks; none for the
+     *  teams out of the matrix. */
+    FORCEINLINE static uint64 GetTeamMask(const uint8 Team)
+    {
+        return Team < MAX_TEAMS ? (uint64(1) << Team) : 0;
+    }
+
+    /** Returns the teams a team is hostile to. */
+    FORCEINLINE static uint64 GetHostileMask(const uint8 Team)
+    {
+        return Team < MAX_TEAMS ? HostileMasks[Team] : 0;
+    }
+
+    /** Returns the teams a team is friendly to. */
+    FORCEINLINE static uint64 GetFriendlyMask(const uint8 Team)
+    {
+        return Team < MAX_TEAMS ? FriendlyMasks[Team] : 0;
+    }
+
+    /** Determines whether a team is neutral or not. */
+    FORCEINLINE static bool IsNeutral(const uint8 Team)
+    {
+        return Team >= MAX_TEAMS;
+    }
+
+    /** Determines whether teams A and B are friendly or not. */
+    FORCEINLINE static bool AreFriendly(const uint8 TeamA, const uint8 TeamB)
+    {
+        return TeamA == TeamB || (GetFriendlyMask(TeamA) & GetTeamMask(TeamB));
+    }
+
+    /** Determines whether teams A and B are enemies or not. */
+    FORCEINLINE static bool AreEnemies(const uint8 TeamA, const uint8 TeamB)
+    {
+        return (GetHostileMask(TeamA) & GetTeamMask(TeamB)) != 0;
+    }
+
+    /** Collects the indices of the teams hostile to a team. */
+    static void FilterHostiles(const uint8 Team,
+                               const TArrayView<const uint8>& Teams,
+                               TArray<int32>& Out_Indices);
+
+    /** Collects the actors hostile to a team. */
+    static void FilterHostiles(const uint8 Team,
+                               const TArrayView<AActor* const>& Actors,
+                               TArray<AActor*>& Out_Hostiles);
+
     /** Determines whether an actor is neutral or not. */
-    static bool IsNeutral(AActor* Actor);
+    static bool IsNeutral(const AActor* Actor);
 
     /** Determines whether actors A and B are friendly or not. */
-    static bool AreFriendly(AActor* ActorA, AActor* ActorB);
+    static bool AreFriendly(const AActor* ActorA, const AActor* ActorB);
 
     /** Determines whether actors A and B are enemies or not. */
-    FORCEINLINE static bool AreEnemies(AActor* ActorA, AActor* ActorB)
+    FORCEINLINE static bool AreEnemies(const AActor* ActorA,
+                                       const AActor* ActorB)
     {
-        return (!IsNeutral(ActorA) && !IsNeutral(ActorB)
-                && !AreFriendly(ActorA, ActorB));
+        checkf(ActorA, TEXT("%s"), TEXT("FATAL: Actor A is NULL!"));
+        checkf(ActorB, TEXT("%s"), TEXT("FATAL: Actor B is NULL!"));
+
+        return AreEnemies(GetTeamNumber(ActorA), GetTeamNumber(ActorB));
     }
 
 protected:
@@ -43,11 +135,9 @@ public:
         return TeamNumber;
     }
 
-    /** Sets the team number */
-    FORCEINLINE void SetTeamNumber(const uint8 Number)
-    {
-        TeamNumber = Number;
-    }
+    /** Sets the team number; a team agent owner gets the new team id as
+     *  well. */
+    void SetTeamNumber(const uint8 Number);
 
     /** Returns the team color */
     FORCEINLINE const FColor& GetTeamColor() const
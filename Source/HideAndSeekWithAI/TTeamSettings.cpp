@@ -0,0 +1,42 @@
+#include "TTeamSettings.h"
+#include "HideAndSeekWithAI.h"
+
+#include "TTeamComponent.h"
+
+FTTeamRelation::FTTeamRelation()
+    : TeamA(0),
+      TeamB(0),
+      Attitude(ETeamAttitude::Hostile)
+{
+
+}
+
+UTTeamSettings::UTTeamSettings(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    DefaultAttitude = ETeamAttitude::Hostile;
+}
+
+void UTTeamSettings::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    /* The config gets loaded into the default object only. */
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+        UTTeamComponent::LoadAttitudes(*this);
+    }
+}
+
+#if WITH_EDITOR
+void UTTeamSettings::PostEditChangeProperty(
+        FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (HasAnyFlags(RF_ClassDefaultObject))
+    {
+        UTTeamComponent::LoadAttitudes(*this);
+    }
+}
+#endif  /* WITH_EDITOR */
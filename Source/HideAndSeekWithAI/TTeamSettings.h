@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <GenericTeamAgentInterface.h>
+#include <UObject/Object.h>
+#include <UObject/ObjectMacros.h>
+
+#include "TTeamSettings.generated.h"
+
+/** The attitude between two teams, the same both ways. */
+USTRUCT(BlueprintType)
+struct HIDEANDSEEKWITHAI_API FTTeamRelation
+{
+    GENERATED_USTRUCT_BODY()
+
+public:
+    /** The first team number */
+    UPROPERTY(config, EditAnywhere, Category = "Team")
+    uint8 TeamA;
+
+    /** The second team number */
+    UPROPERTY(config, EditAnywhere, Category = "Team")
+    uint8 TeamB;
+
+    /** How the two teams treat each other */
+    UPROPERTY(config, EditAnywhere, Category = "Team")
+    TEnumAsByte<ETeamAttitude::Type> Attitude;
+
+public:
+    FTTeamRelation();
+};
+
+/** The team attitude matrix. A team is always friendly to itself, the pairs
+ *  listed in the relations get their own attitude and the rest get the default
+ *  attitude. Team numbers from UTTeamComponent::MAX_TEAMS on have no team and
+ *  are neutral to everyone. The matrix gets loaded into UTTeamComponent as
+ *  bitmasks whenever the settings get loaded or edited. */
+UCLASS(config=Game, defaultconfig)
+class HIDEANDSEEKWITHAI_API UTTeamSettings : public UObject
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /** The attitude between the teams not listed in the relations. */
+    UPROPERTY(config, EditAnywhere, Category = "Team")
+    TEnumAsByte<ETeamAttitude::Type> DefaultAttitude;
+
+    /** The attitudes between the pairs of teams. */
+    UPROPERTY(config, EditAnywhere, Category = "Team")
+    TArray<FTTeamRelation> Relations;
+
+public:
+    virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(
+            FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif  /* WITH_EDITOR */
+};
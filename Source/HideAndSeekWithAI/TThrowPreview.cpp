@@ -0,0 +1,209 @@
+#include "TThrowPreview.h"
+#include "HideAndSeekWithAI.h"
+
+#include <Components/LineBatchComponent.h>
+#include <Engine/World.h>
+#include <Math/UnrealMathUtility.h>
+
+/** The radius of the cross drawn at the landing location. */
+static constexpr float LANDING_MARKER_RADIUS = 20.0f;
+
+/** Returns the position on the arc at a time. */
+static FORCEINLINE FVector Evaluate(const FVector& Start,
+                                    const FVector& Velocity,
+                                    const float GravityZ, const float Time)
+{
+    return Start + Velocity * Time
+            + FVector(0.0f, 0.0f, 0.5f * GravityZ * Time * Time);
+}
+
+/** Solves A * T^2 + B * T + C = 0; the roots come in ascending order. */
+static bool SolveQuadratic(const float A, const float B, const float C,
+                           float& Out_T0, float& Out_T1)
+{
+    if (FMath::IsNearlyZero(A))
+    {
+        if (FMath::IsNearlyZero(B))
+        {
+            return false;
+        }
+
+        Out_T0 = Out_T1 = -C / B;
+        return true;
+    }
+
+    const float Discriminant = B * B - 4.0f * A * C;
+    if (Discriminant < 0.0f)
+    {
+        return false;
+    }
+
+    const float Root = FMath::Sqrt(Discriminant);
+    Out_T0 = (-B - Root) / (2.0f * A);
+    Out_T1 = (-B + Root) / (2.0f * A);
+
+    if (Out_T0 > Out_T1)
+    {
+        Swap(Out_T0, Out_T1);
+    }
+
+    return true;
+}
+
+/** Narrows [Out_Min, Out_Max] down to the times a linear motion stays within
+ *  [Min, Max]. */
+static bool ClipLinear(const float Start, const float Velocity,
+                       const float Min, const float Max,
+                       float& Out_Min, float& Out_Max)
+{
+    if (FMath::IsNearlyZero(Velocity))
+    {
+        return Start >= Min && Start <= Max;
+    }
+
+    float T0 = (Min - Start) / Velocity;
+    float T1 = (Max - Start) / Velocity;
+
+    if (T0 > T1)
+    {
+        Swap(T0, T1);
+    }
+
+    Out_Min = FMath::Max(Out_Min, T0);
+    Out_Max = FMath::Min(Out_Max, T1);
+
+    return Out_Min <= Out_Max;
+}
+
+FTThrowPreview::FTThrowPreview()
+    : Start(FVector::ZeroVector),
+      Velocity(FVector::ZeroVector),
+      bValid(false)
+{
+
+}
+
+void FTThrowPreview::Update(const FVector& InStart, const FVector& InVelocity,
+                            const float GravityZ, const float FloorZ,
+                            const FVector& ItemExtent,
+                            const TArray<FBox>& Obstacles)
+{
+    if (bValid && InStart.Equals(Start) && InVelocity.Equals(Velocity))
+    {
+        return;
+    }
+
+    Start = InStart;
+    Velocity = InVelocity;
+
+    /* The item's center touches the floor one half height above it. */
+    float LandingTime = SolveDescent(Start.Z, Velocity.Z, GravityZ,
+                                     FloorZ + ItemExtent.Z);
+
+    bValid = (LandingTime > 0.0f);
+    if (!bValid)
+    {
+        return;
+    }
+
+    for (const FBox& Obstacle : Obstacles)
+    {
+        const float HitTime = IntersectBox(Start, Velocity, GravityZ,
+                                           Obstacle.ExpandBy(ItemExtent),
+                                           LandingTime);
+        if (HitTime > 0.0f)
+        {
+            LandingTime = HitTime;
+        }
+    }
+
+    for (int32 Point = 0; Point <= SEGMENTS; ++Point)
+    {
+        const float Time = LandingTime * Point / SEGMENTS;
+        Points[Point] = Evaluate(Start, Velocity, GravityZ, Time);
+    }
+}
+
+void FTThrowPreview::Reset()
+{
+    bValid = false;
+}
+
+void FTThrowPreview::Draw(UWorld* World, const FColor& Color) const
+{
+    if (!bValid || !World || !World->LineBatcher)
+    {
+        return;
+    }
+
+    ULineBatchComponent* LineBatcher = World->LineBatcher;
+
+    for (int32 Point = 1; Point <= SEGMENTS; ++Point)
+    {
+        LineBatcher->DrawLine(Points[Point - 1], Points[Point],
+                              Color, SDPG_World, 1.0f, 0.0f);
+    }
+
+    const FVector& Landing = GetLandingLocation();
+    LineBatcher->DrawLine(Landing - FVector(LANDING_MARKER_RADIUS, 0.0f, 0.0f),
+                          Landing + FVector(LANDING_MARKER_RADIUS, 0.0f, 0.0f),
+                          Color, SDPG_World, 2.0f, 0.0f);
+    LineBatcher->DrawLine(Landing - FVector(0.0f, LANDING_MARKER_RADIUS, 0.0f),
+                          Landing + FVector(0.0f, LANDING_MARKER_RADIUS, 0.0f),
+                          Color, SDPG_World, 2.0f, 0.0f);
+}
+
+float FTThrowPreview::SolveDescent(const float StartZ, const float VelocityZ,
+                                   const float GravityZ, const float Z)
+{
+    float T0 = 0.0f;
+    float T1 = 0.0f;
+
+    if (!SolveQuadratic(0.5f * GravityZ, VelocityZ, StartZ - Z, T0, T1))
+    {
+        return -1.0f;
+    }
+
+    /* With gravity pulling down, the later root is on the way down. */
+    return GravityZ < 0.0f ? T1 : T0;
+}
+
+float FTThrowPreview::IntersectBox(const FVector& InStart,
+                                   const FVector& InVelocity,
+                                   const float GravityZ, const FBox& Box,
+                                   const float MaxTime)
+{
+    float MinTime = 0.0f;
+    float EndTime = MaxTime;
+
+    if (!ClipLinear(InStart.X, InVelocity.X, Box.Min.X, Box.Max.X,
+                    MinTime, EndTime)
+            || !ClipLinear(InStart.Y, InVelocity.Y, Box.Min.Y, Box.Max.Y,
+                           MinTime, EndTime))
+    {
+        return -1.0f;
+    }
+
+    const float A = 0.5f * GravityZ;
+    float T0 = 0.0f;
+    float T1 = 0.0f;
+
+    /* The arc is above the bottom of the box between the two roots only. */
+    if (!SolveQuadratic(A, InVelocity.Z, InStart.Z - Box.Min.Z, T0, T1))
+    {
+        return -1.0f;
+    }
+
+    MinTime = FMath::Max(MinTime, T0);
+    EndTime = FMath::Min(EndTime, T1);
+
+    /* Between these two roots it flies over the top of the box instead; so,
+     * it enters through the top once the second one has passed. */
+    if (SolveQuadratic(A, InVelocity.Z, InStart.Z - Box.Max.Z, T0, T1)
+            && MinTime > T0 && MinTime < T1)
+    {
+        MinTime = T1;
+    }
+
+    return MinTime <= EndTime ? MinTime : -1.0f;
+}
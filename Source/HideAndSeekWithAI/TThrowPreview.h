@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <Math/Box.h>
+#include <Math/Color.h>
+#include <Math/Vector.h>
+
+class UWorld;
+
+/** Predicts where a thrown item lands without any physics sweep. The flight is
+ *  the closed form ballistic arc of the launch velocity; it gets intersected
+ *  analytically against the floor plane and the cached obstacle bounding
+ *  boxes, grown by the item's extent. The arc is sampled into a fixed number
+ *  of points only when the launch changes and gets drawn through the world's
+ *  line batcher. Damping and bounces are ignored; so, this is where the item
+ *  first touches something. */
+class HIDEANDSEEKWITHAI_API FTThrowPreview
+{
+public:
+    /** The number of line segments the arc gets drawn with. */
+    static constexpr int32 SEGMENTS = 24;
+
+private:
+    /** The sampled arc, from the launch to the landing location. */
+    FVector Points[SEGMENTS + 1];
+
+    /** The launch location of the sampled arc. */
+    FVector Start;
+
+    /** The launch velocity of the sampled arc. */
+    FVector Velocity;
+
+    /** Whether the arc lands anywhere or not. */
+    bool bValid;
+
+public:
+    FTThrowPreview();
+
+    /** Solves the arc of a launch; does nothing if the launch has not changed
+     *  since the last update. */
+    void Update(const FVector& InStart, const FVector& InVelocity,
+                const float GravityZ, const float FloorZ,
+                const FVector& ItemExtent, const TArray<FBox>& Obstacles);
+
+    /** Forgets the arc, e.g. when the throw ends. */
+    void Reset();
+
+    /** Draws the arc and the landing location for the current frame. */
+    void Draw(UWorld* World, const FColor& Color) const;
+
+    /** Returns whether the arc lands anywhere or not. */
+    FORCEINLINE bool IsValid() const
+    {
+        return bValid;
+    }
+
+    /** Returns where the item lands. */
+    FORCEINLINE const FVector& GetLandingLocation() const
+    {
+        return Points[SEGMENTS];
+    }
+
+    /** Returns the time the arc reaches a height on its way down, or a
+     *  negative time if it never does. */
+    static float SolveDescent(const float StartZ, const float VelocityZ,
+                              const float GravityZ, const float Z);
+
+    /** Returns the earliest time within [0, MaxTime] the arc is inside a box,
+     *  or a negative time if it never is. */
+    static float IntersectBox(const FVector& InStart, const FVector& InVelocity,
+                              const float GravityZ, const FBox& Box,
+                              const float MaxTime);
+};
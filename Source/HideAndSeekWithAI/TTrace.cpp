@@ -0,0 +1,136 @@
+#include "TTrace.h"
+
+#include <GameFramework/Actor.h>
+#include <HAL/PlatformTime.h>
+#include <Perception/AIPerceptionTypes.h>
+
+#if UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL(HideAndSeekChannel)
+
+UE_TRACE_EVENT_BEGIN(HideAndSeek, AIStateChange)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, BotId)
+    UE_TRACE_EVENT_FIELD(uint8, OldState)
+    UE_TRACE_EVENT_FIELD(uint8, NewState)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(HideAndSeek, PerceptionStimulus)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, BotId)
+    UE_TRACE_EVENT_FIELD(uint32, TargetId)
+    UE_TRACE_EVENT_FIELD(uint8, Sense)
+    UE_TRACE_EVENT_FIELD(uint8, Sensed)
+    UE_TRACE_EVENT_FIELD(float, LocationX)
+    UE_TRACE_EVENT_FIELD(float, LocationY)
+    UE_TRACE_EVENT_FIELD(float, LocationZ)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(HideAndSeek, MoveRequest)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, BotId)
+    UE_TRACE_EVENT_FIELD(uint8, Result)
+    UE_TRACE_EVENT_FIELD(float, GoalX)
+    UE_TRACE_EVENT_FIELD(float, GoalY)
+    UE_TRACE_EVENT_FIELD(float, GoalZ)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(HideAndSeek, MoveCompleted)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint32, BotId)
+    UE_TRACE_EVENT_FIELD(uint32, RequestId)
+    UE_TRACE_EVENT_FIELD(uint8, Result)
+UE_TRACE_EVENT_END()
+
+/** Returns the id the actor is known by in the trace, or zero. */
+static FORCEINLINE uint32 GetTraceId(const AActor* Actor)
+{
+    return Actor ? Actor->GetUniqueID() : 0;
+}
+
+void FTTrace::OutputAIStateChange(const AActor* Bot,
+                                  const EAIState& OldState,
+                                  const EAIState& NewState)
+{
+    UE_TRACE_LOG(HideAndSeek, AIStateChange, HideAndSeekChannel)
+            << AIStateChange.Cycle(FPlatformTime::Cycles64())
+            << AIStateChange.BotId(GetTraceId(Bot))
+            << AIStateChange.OldState(static_cast<uint8>(OldState))
+            << AIStateChange.NewState(static_cast<uint8>(NewState));
+}
+
+void FTTrace::OutputPerceptionStimulus(const AActor* Bot,
+                                       const AActor* Target,
+                                       const FAIStimulus& Stimulus)
+{
+    UE_TRACE_LOG(HideAndSeek, PerceptionStimulus, HideAndSeekChannel)
+            << PerceptionStimulus.Cycle(FPlatformTime::Cycles64())
+            << PerceptionStimulus.BotId(GetTraceId(Bot))
+            << PerceptionStimulus.TargetId(GetTraceId(Target))
+            << PerceptionStimulus.Sense(
+                   static_cast<uint8>(Stimulus.Type.Index))
+            << PerceptionStimulus.Sensed(Stimulus.WasSuccessfullySensed() ? 1 : 0)
+            << PerceptionStimulus.LocationX(Stimulus.StimulusLocation.X)
+            << PerceptionStimulus.LocationY(Stimulus.StimulusLocation.Y)
+            << PerceptionStimulus.LocationZ(Stimulus.StimulusLocation.Z);
+}
+
+void FTTrace::OutputMoveRequest(const AActor* Bot, const FVector& Goal,
+                                const uint8 Result)
+{
+    UE_TRACE_LOG(HideAndSeek, MoveRequest, HideAndSeekChannel)
+            << MoveRequest.Cycle(FPlatformTime::Cycles64())
+            << MoveRequest.BotId(GetTraceId(Bot))
+            << MoveRequest.Result(Result)
+            << MoveRequest.GoalX(Goal.X)
+            << MoveRequest.GoalY(Goal.Y)
+            << MoveRequest.GoalZ(Goal.Z);
+}
+
+void FTTrace::OutputMoveCompleted(const AActor* Bot, const uint32 RequestId,
+                                  const uint8 Result)
+{
+    UE_TRACE_LOG(HideAndSeek, MoveCompleted, HideAndSeekChannel)
+            << MoveCompleted.Cycle(FPlatformTime::Cycles64())
+            << MoveCompleted.BotId(GetTraceId(Bot))
+            << MoveCompleted.RequestId(RequestId)
+            << MoveCompleted.Result(Result);
+}
+
+#else
+
+void FTTrace::OutputAIStateChange(const AActor* Bot,
+                                  const EAIState& OldState,
+                                  const EAIState& NewState)
+{
+    (void)Bot;
+    (void)OldState;
+    (void)NewState;
+}
+
+void FTTrace::OutputPerceptionStimulus(const AActor* Bot,
+                                       const AActor* Target,
+                                       const FAIStimulus& Stimulus)
+{
+    (void)Bot;
+    (void)Target;
+    (void)Stimulus;
+}
+
+void FTTrace::OutputMoveRequest(const AActor* Bot, const FVector& Goal,
+                                const uint8 Result)
+{
+    (void)Bot;
+    (void)Goal;
+    (void)Result;
+}
+
+void FTTrace::OutputMoveCompleted(const AActor* Bot, const uint32 RequestId,
+                                  const uint8 Result)
+{
+    (void)Bot;
+    (void)RequestId;
+    (void)Result;
+}
+
+#endif  /* UE_TRACE_ENABLED */
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <CoreTypes.h>
+#include <Math/Vector.h>
+#include <Trace/Trace.h>
+
+#include "HideAndSeekWithAI.h"
+
+class AActor;
+struct FAIStimulus;
+
+/** Emits the AI events into the 'HideAndSeek' Unreal Insights trace channel.
+ *  Run the game with '-trace=cpu,frame,HideAndSeek' in order to line up the
+ *  AI behavior with the frame timings. All the events carry a cycle time
+ *  stamp and the unique id of the bot. */
+struct HIDEANDSEEKWITHAI_API FTTrace
+{
+    /** A bot went from one AI state to another. */
+    static void OutputAIStateChange(const AActor* Bot,
+                                    const EAIState& OldState,
+                                    const EAIState& NewState);
+
+    /** A bot's perception got updated by a stimulus from a target. */
+    static void OutputPerceptionStimulus(const AActor* Bot,
+                                         const AActor* Target,
+                                         const FAIStimulus& Stimulus);
+
+    /** A bot issued a move request. */
+    static void OutputMoveRequest(const AActor* Bot, const FVector& Goal,
+                                  const uint8 Result);
+
+    /** A bot's move request finished. */
+    static void OutputMoveCompleted(const AActor* Bot, const uint32 RequestId,
+                                    const uint8 Result);
+};
+
+#if UE_TRACE_ENABLED
+#define TTRACE_AI_STATE_CHANGE( Bot, OldState, NewState )  \
+    FTTrace::OutputAIStateChange( Bot, OldState, NewState )
+#define TTRACE_PERCEPTION_STIMULUS( Bot, Target, Stimulus )  \
+    FTTrace::OutputPerceptionStimulus( Bot, Target, Stimulus )
+#define TTRACE_MOVE_REQUEST( Bot, Goal, Result )  \
+    FTTrace::OutputMoveRequest( Bot, Goal, Result )
+#define TTRACE_MOVE_COMPLETED( Bot, RequestId, Result )  \
+    FTTrace::OutputMoveCompleted( Bot, RequestId, Result )
+#else
+#define TTRACE_AI_STATE_CHANGE( Bot, OldState, NewState )
+#define TTRACE_PERCEPTION_STIMULUS( Bot, Target, Stimulus )
+#define TTRACE_MOVE_REQUEST( Bot, Goal, Result )
+#define TTRACE_MOVE_COMPLETED( Bot, RequestId, Result )
+#endif  /* UE_TRACE_ENABLED */
@@ -0,0 +1,173 @@
+#include "TTrajectoryRenderer.h"
+#include "HideAndSeekWithAI.h"
+
+#include <DrawDebugHelpers.h>
+#include <Engine/World.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/DateTime.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+#include "TLog.h"
+#include "TPickup.h"
+#include "TPickupTrajectory.h"
+#include "TStats.h"
+
+static constexpr uint64 TLOG_KEY_ITEM_TRAJECTORY = TLOG_KEY_GENERIC + 3100;
+
+static TAutoConsoleVariable<int32> CVarPickupTrajectories(
+        TEXT("t.Pickup.Trajectories"),
+        1,
+        TEXT("Draws the recent flights of the pickup items.\n"
+             " 0: off\n"
+             " 1: on"),
+        ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPickupTrajectoryLifetime(
+        TEXT("t.Pickup.TrajectoryLifetime"),
+        4.0f,
+        TEXT("Seconds each segment of a pickup item's flight stays on"
+             " screen."),
+        ECVF_Default);
+
+/** Exports the trajectories of the world the command runs in. */
+static void ExportTrajectories(UWorld* World)
+{
+    const UTTrajectoryRenderer* Renderer =
+            World ? World->GetSubsystem<UTTrajectoryRenderer>() : nullptr;
+
+    if (Renderer)
+    {
+        Renderer->Export();
+    }
+}
+
+static FAutoConsoleCommandWithWorld CmdExportPickupTrajectories(
+        TEXT("t.Pickup.ExportTrajectories"),
+        TEXT("Writes the recorded flights of the pickup items into a CSV file"
+             " under Saved/Trajectories."),
+        FConsoleCommandWithWorldDelegate::CreateStatic(&ExportTrajectories));
+
+void UTTrajectoryRenderer::Register(ATPickup* Pickup)
+{
+    Pickups.AddUnique(Pickup);
+}
+
+void UTTrajectoryRenderer::Unregister(ATPickup* Pickup)
+{
+    Pickups.RemoveSwap(Pickup);
+}
+
+void UTTrajectoryRenderer::Export() const
+{
+    TArray<FString> Rows;
+    Rows.Add(TEXT("Pickup,Sample,Seconds,X,Y,Z,Color"));
+
+    for (const TWeakObjectPtr<ATPickup>& Pickup : Pickups)
+    {
+        if (!Pickup.IsValid())
+        {
+            continue;
+        }
+
+        const FString Name(Pickup->GetName());
+        const FTPickupTrajectory& Trajectory = Pickup->GetTrajectory();
+
+        for (int32 Sample = 0; Sample < Trajectory.Num(); ++Sample)
+        {
+            const FVector& Location = Trajectory.GetLocation(Sample);
+
+            Rows.Add(FString::Printf(TEXT("%s,%d,%.4f,%.3f,%.3f,%.3f,%u"),
+                                     *Name, Sample, Trajectory.GetTime(Sample),
+                                     Location.X, Location.Y, Location.Z,
+                                     Trajectory.GetColorIndex(Sample)));
+        }
+    }
+
+    const FString Path(FPaths::ProjectSavedDir() / TEXT("Trajectories")
+                       / FString::Printf(TEXT("Trajectories-%s.csv"),
+                                         *FDateTime::Now().ToString()));
+
+    if (!FFileHelper::SaveStringArrayToFile(Rows, *Path))
+    {
+        TLOG_ERROR(TLOG_KEY_ITEM_TRAJECTORY,
+                   "ERROR: cannot write the trajectories!", Path);
+        return;
+    }
+
+    TLOG_DISPLAY(TLOG_KEY_ITEM_TRAJECTORY,
+                 "The trajectories have been exported!", Rows.Num() - 1, Path);
+}
+
+void UTTrajectoryRenderer::Tick(float DeltaTime)
+{
+    (void)DeltaTime;
+
+    TSTAT_SCOPE(STAT_HideAndSeek_TrajectoryRenderer);
+
+    UWorld* World = GetWorld();
+    if (!World || !World->LineBatcher
+            || CVarPickupTrajectories.GetValueOnGameThread() == 0)
+    {
+        return;
+    }
+
+    const float Now = World->GetTimeSeconds();
+    const float Lifetime = CVarPickupTrajectoryLifetime.GetValueOnGameThread();
+
+    Lines.Reset();
+
+    for (const TWeakObjectPtr<ATPickup>& Pickup : Pickups)
+    {
+        if (!Pickup.IsValid())
+        {
+            continue;
+        }
+
+        const FTPickupTrajectory& Trajectory = Pickup->GetTrajectory();
+        const int32 Samples = Trajectory.Num();
+
+        /* Most pickup items rest; their latest sample is long gone. */
+        if (Samples < 2 || Now - Trajectory.GetTime(Samples - 1) > Lifetime)
+        {
+            continue;
+        }
+
+        for (int32 Sample = 1; Sample < Samples; ++Sample)
+        {
+            if (Now - Trajectory.GetTime(Sample) > Lifetime)
+            {
+                continue;
+            }
+
+            Lines.Emplace(Trajectory.GetLocation(Sample - 1),
+                          Trajectory.GetLocation(Sample),
+                          FTPickupTrajectory::GetColor(
+                              Trajectory.GetColorIndex(Sample)),
+                          0.0f, 1.0f, SDPG_World);
+        }
+    }
+
+    /* The world flushes this line batcher every frame. */
+    if (Lines.Num() > 0)
+    {
+        World->LineBatcher->DrawLines(Lines);
+    }
+}
+
+bool UTTrajectoryRenderer::IsTickable() const
+{
+    /* Like any debug drawing, the trajectories are gone in shipping builds;
+     * they still get recorded for the export though. */
+    return ENABLE_DRAW_DEBUG && !IsTemplate() && Pickups.Num() > 0;
+}
+
+UWorld* UTTrajectoryRenderer::GetTickableGameObjectWorld() const
+{
+    return GetWorld();
+}
+
+TStatId UTTrajectoryRenderer::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTTrajectoryRenderer, STATGROUP_Tickables);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Components/LineBatchComponent.h>
+#include <Containers/Array.h>
+#include <CoreTypes.h>
+#include <Stats/Stats.h>
+#include <Subsystems/WorldSubsystem.h>
+#include <Tickable.h>
+#include <UObject/ObjectMacros.h>
+#include <UObject/WeakObjectPtrTemplates.h>
+
+#include "TTrajectoryRenderer.generated.h"
+
+class ATPickup;
+
+/** Draws the recorded flights of all the pickup items in the world as a single
+ *  batch of lines per frame, instead of each pickup item adding its own
+ *  persistent lines. 't.Pickup.Trajectories' turns the drawing on or off and
+ *  't.Pickup.ExportTrajectories' writes the recorded flights into a CSV file
+ *  under Saved/Trajectories. */
+UCLASS()
+class HIDEANDSEEKWITHAI_API UTTrajectoryRenderer : public UWorldSubsystem,
+        public FTickableGameObject
+{
+    GENERATED_BODY()
+
+private:
+    /** The pickup items whose trajectories get drawn. */
+    TArray<TWeakObjectPtr<ATPickup>> Pickups;
+
+    /** The lines of the current frame; kept around to reuse the memory. */
+    TArray<FBatchedLine> Lines;
+
+public:
+    /** Starts drawing the trajectory of a pickup item. */
+    void Register(ATPickup* Pickup);
+
+    /** Stops drawing the trajectory of a pickup item. */
+    void Unregister(ATPickup* Pickup);
+
+    /** Writes the recorded trajectories into a CSV file. */
+    void Export() const;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual UWorld* GetTickableGameObjectWorld() const override;
+    virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,614 @@
+#include "HideAndSeekWithAI.h"
+
+#include <Containers/Array.h>
+#include <Containers/Map.h>
+#include <Dom/JsonObject.h>
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+#include <GameFramework/PlayerController.h>
+#include <HAL/PlatformTime.h>
+#include <Math/RandomStream.h>
+#include <Misc/AutomationTest.h>
+#include <Misc/CommandLine.h>
+#include <Misc/DateTime.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Parse.h>
+#include <Misc/Paths.h>
+#include <Serialization/JsonSerializer.h>
+#include <Serialization/JsonWriter.h>
+#include <Templates/SharedPointer.h>
+#include <Tests/AutomationCommon.h>
+
+#include "TBenchmarkSettings.h"
+#include "TGameInstance.h"
+#include "TGameState.h"
+#include "TPickup.h"
+#include "TPlayerCharacter.h"
+#include "TStats.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && TSTAT_FRAME_COUNTERS
+
+/* Run headless with:
+ *   UE4Editor-Cmd HideAndSeekWithAI.uproject -game -nullrhi -unattended
+ *       -ExecCmds="Automation RunTests HideAndSeekWithAI.Benchmark; Quit"
+ * Results are written to Saved/Benchmarks. */
+
+static constexpr uint32 BENCHMARK_FLAGS =
+        EAutomationTestFlags::ClientContext
+        | EAutomationTestFlags::EditorContext
+        | EAutomationTestFlags::PerfFilter;
+
+/** The number of bots of the benchmarks not scaling the AI. */
+static constexpr int32 BENCHMARK_BOTS = 60;
+
+/** The metrics gathered by a single benchmark. */
+struct FTBenchmarkResults
+{
+    /** The benchmark name, also the prefix of all the metrics. */
+    FString Name;
+
+    /** The map URL the benchmark runs on. */
+    FString URL;
+
+    /** The number of bots the benchmark asks for. */
+    int32 Bots;
+
+    /** The measured metrics; lower is always better. */
+    TMap<FString, double> Metrics;
+
+    FTBenchmarkResults(const FString& InName, const FString& InURL,
+                       const int32 InBots)
+        : Name(InName),
+          URL(InURL),
+          Bots(InBots)
+    {
+
+    }
+
+    void Add(const FString& Metric, const double Value)
+    {
+        Metrics.Add(FString::Printf(TEXT("%s.%s"), *Name, *Metric), Value);
+    }
+};
+
+typedef TSharedRef<FTBenchmarkResults> FTBenchmarkResultsRef;
+
+/** Returns the world the game is running in, either standalone or PIE. */
+static UWorld* GetBenchmarkWorld()
+{
+    if (!GEngine)
+    {
+        return nullptr;
+    }
+
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        if ((Context.WorldType == EWorldType::Game
+             || Context.WorldType == EWorldType::PIE)
+                && Context.World())
+        {
+            return Context.World();
+        }
+    }
+
+    return nullptr;
+}
+
+/** Builds the map URL of a benchmark. The benchmark name is passed on as an
+ *  option in order to tell the benchmark's world apart from the previous one.
+ *  The safe start is off, since rerolling the bots too close to the player
+ *  gives up after a number of retries and would leave bots out. */
+static FString GetBenchmarkURL(const FString& Name, const int32 Bots)
+{
+    const UTBenchmarkSettings* Settings = GetDefault<UTBenchmarkSettings>();
+
+    return FString::Printf(TEXT("%s?Bots=%d?Seed=%d?SafeStart=0?Benchmark=%s"),
+                           *Settings->Map, Bots, Settings->Seed, *Name);
+}
+
+/** Makes the benchmark fail unless all the bots it asks for got spawned. */
+static bool CheckBotCount(FAutomationTestBase* Test, const UWorld* World,
+                          const FTBenchmarkResultsRef& Results)
+{
+    const ATGameState* GameState = World->GetGameState<ATGameState>();
+    if (!GameState)
+    {
+        Test->AddError(TEXT("Not HideAndSeekWithAI's game state!"));
+        return false;
+    }
+
+    if (GameState->GetBots().Num() != Results->Bots)
+    {
+        Test->AddError(FString::Printf(
+                           TEXT("Spawned %d bots instead of %d!"),
+                           GameState->GetBots().Num(), Results->Bots));
+        return false;
+    }
+
+    return true;
+}
+
+/** Returns the benchmark's world once it has been loaded and started. */
+static UWorld* GetLoadedBenchmarkWorld(const FTBenchmarkResultsRef& Results)
+{
+    UWorld* World = GetBenchmarkWorld();
+    if (!World || !World->HasBegunPlay())
+    {
+        return nullptr;
+    }
+
+    if (World->URL.GetOption(TEXT("Benchmark="), TEXT(""))
+            != Results->Name)
+    {
+        return nullptr;
+    }
+
+    return World;
+}
+
+/** Waits for the benchmark's world to load and warm up, then records the
+ *  layout spawn time. */
+class FTWaitForBenchmarkWorldCommand : public IAutomationLatentCommand
+{
+public:
+    FTWaitForBenchmarkWorldCommand(FAutomationTestBase* InTest,
+                                   const FTBenchmarkResultsRef& InResults)
+        : Test(InTest),
+          Results(InResults),
+          WarmedUpFrames(0)
+    {
+
+    }
+
+    virtual bool Update() override
+    {
+        const UTBenchmarkSettings* Settings = GetDefault<UTBenchmarkSettings>();
+
+        const UWorld* World = GetLoadedBenchmarkWorld(Results);
+        if (!World)
+        {
+            if (GetCurrentRunTime() > Settings->LoadTimeout)
+            {
+                Test->AddError(FString::Printf(
+                                   TEXT("Timed out loading '%s'!"),
+                                   *Results->URL));
+                return true;
+            }
+
+            return false;
+        }
+
+        if (++WarmedUpFrames < Settings->WarmupFrames)
+        {
+            return false;
+        }
+
+        CheckBotCount(Test, World, Results);
+
+        Results->Add(TEXT("LayoutSpawnMs"),
+                     FTStats::LastLayoutSpawnTime * 1000.0);
+
+        return true;
+    }
+
+private:
+    FAutomationTestBase* Test;
+    FTBenchmarkResultsRef Results;
+    int32 WarmedUpFrames;
+};
+
+/** Samples the AI frame counters for a number of frames. When a throw rate
+ *  is given, pickup items rain down around the player on every frame, which
+ *  makes every bot in range handle hearing events. */
+class FTSampleFramesCommand : public IAutomationLatentCommand
+{
+public:
+    FTSampleFramesCommand(FAutomationTestBase* InTest,
+                          const FTBenchmarkResultsRef& InResults,
+                          const int32 InThrowsPerFrame = 0)
+        : Test(InTest),
+          Results(InResults),
+          ThrowsPerFrame(InThrowsPerFrame),
+          NextPickupIndex(0),
+          bStarted(false),
+          PerceptionCycles(0),
+          PathRequests(0),
+          SightChecks(0),
+          NoiseEvents(0)
+    {
+        RandomStream.Initialize(GetDefault<UTBenchmarkSettings>()->Seed);
+    }
+
+    virtual bool Update() override
+    {
+        UWorld* World = GetLoadedBenchmarkWorld(Results);
+        if (!World)
+        {
+            Test->AddError(TEXT("The benchmark world went away while"
+                                " sampling!"));
+            return true;
+        }
+
+        const FTFrameCounters& Counters(FTStats::LastFrameCounters);
+
+        /* The latest complete frame is only part of the sampling window from
+         * the second update on. */
+        if (bStarted)
+        {
+            AIFrameTimes.Add(FPlatformTime::ToMilliseconds64(
+                                 Counters.AICycles));
+            PerceptionCycles += Counters.PerceptionCycles;
+            PathRequests += Counters.PathRequests;
+            SightChecks += Counters.SightChecks;
+            NoiseEvents += Counters.NoiseEvents;
+        }
+
+        bStarted = true;
+
+        if (AIFrameTimes.Num()
+                >= GetDefault<UTBenchmarkSettings>()->SampleFrames)
+        {
+            Report();
+            return true;
+        }
+
+        if (ThrowsPerFrame > 0)
+        {
+            ThrowPickups(World);
+        }
+
+        return false;
+    }
+
+private:
+    FAutomationTestBase* Test;
+    FTBenchmarkResultsRef Results;
+    const int32 ThrowsPerFrame;
+
+    FRandomStream RandomStream;
+    TArray<TWeakObjectPtr<ATPickup>> Pickups;
+    int32 NextPickupIndex;
+
+    bool bStarted;
+    TArray<double> AIFrameTimes;
+    uint64 PerceptionCycles;
+    int64 PathRequests;
+    int64 SightChecks;
+    int64 NoiseEvents;
+
+    void ThrowPickups(UWorld* World)
+    {
+        const APlayerController* PlayerController =
+                World->GetFirstPlayerController();
+        ATPlayerCharacter* PlayerCharacter = PlayerController
+                ? Cast<ATPlayerCharacter>(PlayerController->GetPawn())
+                : nullptr;
+        if (!PlayerCharacter)
+        {
+            return;
+        }
+
+        if (Pickups.Num() == 0)
+        {
+            for (TActorIterator<ATPickup> ActorItr(World); ActorItr; ++ActorItr)
+            {
+                Pickups.Add(*ActorItr);
+            }
+
+            if (Pickups.Num() == 0)
+            {
+                return;
+            }
+        }
+
+        const FVector Origin(PlayerCharacter->GetActorLocation());
+
+        for (int32 ThrowIndex = 0; ThrowIndex < ThrowsPerFrame; ++ThrowIndex)
+        {
+            ATPickup* Pickup = Pickups[NextPickupIndex].Get();
+            NextPickupIndex = (NextPickupIndex + 1) % Pickups.Num();
+
+            if (!Pickup || Pickup->IsAttachedToACharacter())
+            {
+                continue;
+            }
+
+            /* Going through the player's hands makes the player the noise
+             * instigator, exactly as a real throw does. */
+            Pickup->AttachToCharacter(PlayerCharacter);
+            Pickup->DetachFromCharacter(PlayerCharacter);
+
+            const FVector Location(
+                        Origin + FVector(RandomStream.FRandRange(-1500.0f, 1500.0f),
+                                         RandomStream.FRandRange(-1500.0f, 1500.0f),
+                                         300.0f));
+            Pickup->SetActorLocation(Location, false, nullptr,
+                                     ETeleportType::TeleportPhysics);
+            Pickup->Launch(FVector(0.0f, 0.0f, -600.0f));
+        }
+    }
+
+    void Report()
+    {
+        const int32 Frames = AIFrameTimes.Num();
+
+        double Total = 0.0;
+        for (const double FrameTime : AIFrameTimes)
+        {
+            Total += FrameTime;
+        }
+
+        AIFrameTimes.Sort();
+        const int32 P95Index = FMath::Clamp(
+                    FMath::CeilToInt(Frames * 0.95f) - 1, 0, Frames - 1);
+
+        Results->Add(TEXT("AIMsMean"), Total / Frames);
+        Results->Add(TEXT("AIMsP95"), AIFrameTimes[P95Index]);
+        Results->Add(TEXT("PathRequestsPerFrame"),
+                     static_cast<double>(PathRequests) / Frames);
+        Results->Add(TEXT("SightChecksPerFrame"),
+                     static_cast<double>(SightChecks) / Frames);
+
+        if (ThrowsPerFrame > 0)
+        {
+            const double PerceptionMs =
+                    FPlatformTime::ToMilliseconds64(PerceptionCycles);
+
+            Results->Add(TEXT("PerceptionMsMean"), PerceptionMs / Frames);
+            Results->Add(TEXT("PerceptionMsPerNoiseEvent"),
+                         NoiseEvents > 0 ? PerceptionMs / NoiseEvents : 0.0);
+
+            if (NoiseEvents == 0)
+            {
+                Test->AddError(TEXT("The throw storm made no noise at all!"));
+            }
+        }
+    }
+};
+
+/** Restarts the current level and waits for the new layout. */
+class FTRestartLevelCommand : public IAutomationLatentCommand
+{
+public:
+    FTRestartLevelCommand(FAutomationTestBase* InTest,
+                          const FTBenchmarkResultsRef& InResults)
+        : Test(InTest),
+          Results(InResults),
+          bRestarted(false)
+    {
+
+    }
+
+    virtual bool Update() override
+    {
+        if (!bRestarted)
+        {
+            UWorld* World = GetLoadedBenchmarkWorld(Results);
+            UTGameInstance* GameInstance = World
+                    ? Cast<UTGameInstance>(World->GetGameInstance())
+                    : nullptr;
+            if (!GameInstance)
+            {
+                Test->AddError(TEXT("Not HideAndSeekWithAI's game instance!"));
+                return true;
+            }
+
+            FTStats::LastRestartLatency = 0.0;
+            GameInstance->RestartCurrentLevel();
+            bRestarted = true;
+
+            return false;
+        }
+
+        const UWorld* World = GetLoadedBenchmarkWorld(Results);
+        if (FTStats::LastRestartLatency > 0.0 && World)
+        {
+            CheckBotCount(Test, World, Results);
+
+            Results->Add(TEXT("RestartMs"),
+                         FTStats::LastRestartLatency * 1000.0);
+            return true;
+        }
+
+        if (GetCurrentRunTime() > GetDefault<UTBenchmarkSettings>()->LoadTimeout)
+        {
+            Test->AddError(TEXT("Timed out restarting the level!"));
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    FAutomationTestBase* Test;
+    FTBenchmarkResultsRef Results;
+    bool bRestarted;
+};
+
+/** Compares the metrics against the stored baselines and writes all of them
+ *  to Saved/Benchmarks as JSON. */
+class FTReportBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+    FTReportBenchmarkCommand(FAutomationTestBase* InTest,
+                             const FTBenchmarkResultsRef& InResults)
+        : Test(InTest),
+          Results(InResults)
+    {
+
+    }
+
+    virtual bool Update() override
+    {
+        UTBenchmarkSettings* Settings = GetMutableDefault<UTBenchmarkSettings>();
+        const bool bUpdateBaselines = FParse::Param(
+                    FCommandLine::Get(), TEXT("TBenchmarkUpdateBaselines"));
+
+        TSharedRef<FJsonObject> Root(MakeShared<FJsonObject>());
+        TSharedRef<FJsonObject> Metrics(MakeShared<FJsonObject>());
+        TArray<TSharedPtr<FJsonValue>> Regressions;
+        bool bBaselinesChanged = false;
+
+        for (const TPair<FString, double>& Metric : Results->Metrics)
+        {
+            TSharedRef<FJsonObject> Entry(MakeShared<FJsonObject>());
+            Entry->SetNumberField(TEXT("Value"), Metric.Value);
+
+            const float* Baseline = Settings->Baselines.Find(Metric.Key);
+            if (Baseline)
+            {
+                const float Tolerance = Settings->GetTolerance(Metric.Key);
+                const double Limit = *Baseline * (1.0 + Tolerance);
+
+                Entry->SetNumberField(TEXT("Baseline"), *Baseline);
+                Entry->SetNumberField(TEXT("Tolerance"), Tolerance);
+
+                if (Metric.Value > Limit && !bUpdateBaselines)
+                {
+                    Regressions.Add(MakeShared<FJsonValueString>(Metric.Key));
+                    Test->AddError(FString::Printf(
+                                       TEXT("Regression in %s: %f (baseline %f,"
+                                            " tolerance %.0f%%)"),
+                                       *Metric.Key, Metric.Value, *Baseline,
+                                       Tolerance * 100.0f));
+                }
+            }
+            else if (!bUpdateBaselines)
+            {
+                /* The first run on a machine records the baseline the next
+                 * runs get checked against. */
+                Test->AddWarning(FString::Printf(
+                                     TEXT("No baseline for %s yet; recording"
+                                          " %f"),
+                                     *Metric.Key, Metric.Value));
+            }
+
+            Test->AddInfo(FString::Printf(TEXT("%s = %f"),
+                                          *Metric.Key, Metric.Value));
+
+            if (bUpdateBaselines || !Baseline)
+            {
+                Settings->Baselines.Add(Metric.Key,
+                                        static_cast<float>(Metric.Value));
+                bBaselinesChanged = true;
+            }
+
+            Metrics->SetObjectField(Metric.Key, Entry);
+        }
+
+        if (bBaselinesChanged)
+        {
+            Settings->UpdateDefaultConfigFile();
+        }
+
+        Root->SetStringField(TEXT("Benchmark"), Results->Name);
+        Root->SetStringField(TEXT("URL"), Results->URL);
+        Root->SetStringField(TEXT("Time"), FDateTime::UtcNow().ToIso8601());
+        Root->SetObjectField(TEXT("Metrics"), Metrics);
+        Root->SetArrayField(TEXT("Regressions"), Regressions);
+
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        FJsonSerializer::Serialize(Root, Writer);
+
+        const FString FilePath(
+                    FPaths::ProjectSavedDir() / TEXT("Benchmarks")
+                    / FString::Printf(TEXT("%s-%s.json"), *Results->Name,
+                                      *FDateTime::Now().ToString()));
+        if (!FFileHelper::SaveStringToFile(Json, *FilePath))
+        {
+            Test->AddError(FString::Printf(TEXT("Failed to write '%s'!"),
+                                           *FilePath));
+        }
+
+        return true;
+    }
+
+private:
+    FAutomationTestBase* Test;
+    FTBenchmarkResultsRef Results;
+};
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FTAIScalingBenchmark,
+                                  "HideAndSeekWithAI.Benchmark.AIScaling",
+                                  BENCHMARK_FLAGS)
+
+void FTAIScalingBenchmark::GetTests(TArray<FString>& OutBeautifiedNames,
+                                    TArray<FString>& OutTestCommands) const
+{
+    static const TCHAR* BotCounts[] = { TEXT("6"), TEXT("60"), TEXT("600") };
+
+    for (const TCHAR* Bots : BotCounts)
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%s Bots"), Bots));
+        OutTestCommands.Add(Bots);
+    }
+}
+
+bool FTAIScalingBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 Bots = FCString::Atoi(*Parameters);
+    const FString Name(FString::Printf(TEXT("AIScaling%d"), Bots));
+
+    FTBenchmarkResultsRef Results(
+                MakeShared<FTBenchmarkResults>(
+                    Name, GetBenchmarkURL(Name, Bots), Bots));
+
+    AutomationOpenMap(Results->URL);
+    ADD_LATENT_AUTOMATION_COMMAND(FTWaitForBenchmarkWorldCommand(this, Results));
+    ADD_LATENT_AUTOMATION_COMMAND(FTSampleFramesCommand(this, Results));
+    ADD_LATENT_AUTOMATION_COMMAND(FTReportBenchmarkCommand(this, Results));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTMatchRestartBenchmark,
+                                 "HideAndSeekWithAI.Benchmark.MatchRestart",
+                                 BENCHMARK_FLAGS)
+
+bool FTMatchRestartBenchmark::RunTest(const FString& Parameters)
+{
+    (void)Parameters;
+
+    const FString Name(TEXT("MatchRestart"));
+
+    FTBenchmarkResultsRef Results(
+                MakeShared<FTBenchmarkResults>(
+                    Name, GetBenchmarkURL(Name, BENCHMARK_BOTS),
+                    BENCHMARK_BOTS));
+
+    AutomationOpenMap(Results->URL);
+    ADD_LATENT_AUTOMATION_COMMAND(FTWaitForBenchmarkWorldCommand(this, Results));
+    ADD_LATENT_AUTOMATION_COMMAND(FTRestartLevelCommand(this, Results));
+    ADD_LATENT_AUTOMATION_COMMAND(FTReportBenchmarkCommand(this, Results));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTThrowStormBenchmark,
+                                 "HideAndSeekWithAI.Benchmark.ThrowStorm",
+                                 BENCHMARK_FLAGS)
+
+bool FTThrowStormBenchmark::RunTest(const FString& Parameters)
+{
+    (void)Parameters;
+
+    const FString Name(TEXT("ThrowStorm"));
+
+    FTBenchmarkResultsRef Results(
+                MakeShared<FTBenchmarkResults>(
+                    Name, GetBenchmarkURL(Name, BENCHMARK_BOTS),
+                    BENCHMARK_BOTS));
+
+    AutomationOpenMap(Results->URL);
+    ADD_LATENT_AUTOMATION_COMMAND(FTWaitForBenchmarkWorldCommand(this, Results));
+    ADD_LATENT_AUTOMATION_COMMAND(FTSampleFramesCommand(
+                                      this, Results,
+                                      GetDefault<UTBenchmarkSettings>()->ThrowsPerFrame));
+    ADD_LATENT_AUTOMATION_COMMAND(FTReportBenchmarkCommand(this, Results));
+
+    return true;
+}
+
+#endif  /* WITH_DEV_AUTOMATION_TESTS && TSTAT_FRAME_COUNTERS */
@@ -0,0 +1,122 @@
+#include "HideAndSeekWithAI.h"
+
+#include <Containers/Array.h>
+#include <Containers/UnrealString.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/AutomationTest.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <UObject/Package.h>
+#include <UObject/UObjectGlobals.h>
+
+#include "TLog.h"
+#include "TLogBinary.h"
+#include "TLogDecodeCommandlet.h"
+#include "TLogWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* Run with:
+ *   UE4Editor-Cmd HideAndSeekWithAI.uproject -nullrhi -unattended
+ *       -ExecCmds="Automation RunTests HideAndSeekWithAI.Log; Quit"
+ * Restarts the log writer, so the entries logged meanwhile by other threads
+ * get written synchronously. */
+
+static constexpr uint32 LOG_TEST_FLAGS =
+        EAutomationTestFlags::ClientContext
+        | EAutomationTestFlags::EditorContext
+        | EAutomationTestFlags::ProductFilter;
+
+static constexpr uint64 TLOG_KEY_LOG_BINARY_TEST = TLOG_KEY_GENERIC + 6000;
+
+/** The number of entries pushed before the writer drains for the first
+ *  time. */
+static constexpr int32 ENTRIES = 64;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTLogBinaryDecodeTest,
+                                 "HideAndSeekWithAI.Log.BinaryDecode",
+                                 LOG_TEST_FLAGS)
+
+bool FTLogBinaryDecodeTest::RunTest(const FString& Parameters)
+{
+    (void)Parameters;
+
+    static const TLogSite Site {
+        __FILE__, __FUNCTION__, __LINE__,
+        TLogCore::EVerbosity::Log, TLogCore::ECategory::Generic,
+        TLOG_KEY_LOG_BINARY_TEST
+    };
+
+    /* A fresh writer has no binary log open yet; the entries below get
+     * stamped before its first drain opens one. */
+    const bool bWasRunning = FTLogWriter::IsRunning();
+    FTLogWriter::Shutdown();
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    FTLogWriter::Startup();
+
+    if (!FTLogWriter::IsRunning())
+    {
+        AddWarning(TEXT("The log writer does not run on this platform!"));
+        return true;
+    }
+
+    for (int32 Index = 0; Index < ENTRIES; ++Index)
+    {
+        FTLogPayload Payload;
+        TLogBinary<int32>::Encode(Index, Payload);
+        FTLogWriter::PushBinary(Site, FPlatformTime::Cycles64(), Payload);
+    }
+
+    /* Shutting down drains the rings and closes the binary log. */
+    FTLogWriter::Shutdown();
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+    if (bWasRunning)
+    {
+        FTLogWriter::Startup();
+    }
+
+    const FString Output(FPaths::AutomationTransientDir()
+                         / TEXT("TLogBinaryDecode.csv"));
+
+    UTLogDecodeCommandlet* Commandlet = NewObject<UTLogDecodeCommandlet>(
+                GetTransientPackage());
+    if (Commandlet->Main(FString::Printf(TEXT("-Format=CSV -Output=\"%s\""),
+                                         *Output)) != 0)
+    {
+        AddError(TEXT("The binary log could not be decoded!"));
+        return false;
+    }
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Output))
+    {
+        AddError(FString::Printf(TEXT("Cannot read '%s'!"), *Output));
+        return false;
+    }
+
+    /* Skips the header. */
+    const int32 Entries = Lines.Num() - 1;
+    TestEqual(TEXT("Decoded entries"), Entries, ENTRIES);
+
+    for (int32 Index = 1; Index < Lines.Num(); ++Index)
+    {
+        FString Seconds;
+        Lines[Index].Split(TEXT(","), &Seconds, nullptr);
+
+        const double Value = FCString::Atod(*Seconds);
+        if (Value < 0.0 || Value > ElapsedSeconds)
+        {
+            AddError(FString::Printf(TEXT("Entry %d is stamped at %s seconds,"
+                                          " outside of the %.6f seconds the"
+                                          " recording took!"),
+                                     Index - 1, *Seconds, ElapsedSeconds));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif  /* WITH_DEV_AUTOMATION_TESTS */
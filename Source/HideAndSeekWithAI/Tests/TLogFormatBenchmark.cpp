@@ -0,0 +1,267 @@
+#include "HideAndSeekWithAI.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <Containers/Array.h>
+#include <Containers/StringConv.h>
+#include <HAL/PlatformTime.h>
+#include <Math/RandomStream.h>
+#include <Misc/AutomationTest.h>
+#include <Misc/StringBuilder.h>
+
+#include "TLog.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* Run with:
+ *   UE4Editor-Cmd HideAndSeekWithAI.uproject -nullrhi -unattended
+ *       -ExecCmds="Automation RunTests HideAndSeekWithAI.Benchmark.LogFormat;
+ *                  Quit"
+ * Compares the TLog formatters against the FString based chains they
+ * replaced; the timings end up in the automation log. The floating point
+ * formatters print the shortest round-trip digits instead of the legacy
+ * output. */
+
+static constexpr uint32 LOG_FORMAT_FLAGS =
+        EAutomationTestFlags::ClientContext
+        | EAutomationTestFlags::EditorContext
+        | EAutomationTestFlags::PerfFilter;
+
+/** The number of values each formatter goes through. */
+static constexpr int32 SAMPLES = 4096;
+
+/** The number of passes over the values. */
+static constexpr int32 PASSES = 64;
+
+/** The values both sides format. */
+struct FTLogFormatSamples
+{
+    TArray<double> Doubles;
+    TArray<float> Floats;
+    TArray<int32> Int32s;
+    TArray<int64> Int64s;
+    TArray<FVector> Vectors;
+    TArray<FRotator> Rotators;
+    TArray<FName> Names;
+
+    explicit FTLogFormatSamples(const int32 Seed)
+    {
+        FRandomStream Stream(Seed);
+
+        for (int32 Index = 0; Index < SAMPLES; ++Index)
+        {
+            Doubles.Add(static_cast<double>(Stream.FRandRange(-1.0e4f, 1.0e4f))
+                        / static_cast<double>(Stream.RandRange(1, 1000)));
+            Floats.Add(Stream.FRandRange(-1.0e4f, 1.0e4f));
+            Int32s.Add(Stream.RandHelper(MAX_int32) - MAX_int32 / 2);
+            Int64s.Add(static_cast<int64>(Stream.GetUnsignedInt()) << 24);
+            Vectors.Add(Stream.VRand() * Stream.FRandRange(0.0f, 1.0e4f));
+            Rotators.Add(FRotator(Stream.FRandRange(-180.0f, 180.0f),
+                                  Stream.FRandRange(-180.0f, 180.0f),
+                                  Stream.FRandRange(-180.0f, 180.0f)));
+            Names.Add(FName(TEXT("TBot"), Index));
+        }
+    }
+};
+
+/** The legacy formatters: every argument became an FString of its own before
+ *  getting appended to the entry. These are the very chains the TLogString
+ *  specializations used before; the floating point values printed six
+ *  decimals, not the shortest round-trip digits. */
+struct FTLegacyLogFormat
+{
+    static FString Format(const double Value)
+    {
+        char Buffer[128];
+        std::snprintf(Buffer, sizeof(Buffer), "%f", Value);
+        const std::string String(Buffer);
+        return FString(StringCast<TCHAR>(String.c_str()).Get());
+    }
+
+    static FString Format(const float Value)
+    {
+        return FString::SanitizeFloat(Value);
+    }
+
+    static FString Format(const int32 Value)
+    {
+        return FString::Printf(TEXT("%d"), Value);
+    }
+
+    static FString Format(const int64 Value)
+    {
+        return FString::Printf(TEXT("%lld"), Value);
+    }
+
+    static FString Format(const FVector& Value)
+    {
+        return Value.ToString();
+    }
+
+    static FString Format(const FRotator& Value)
+    {
+        return Value.ToString();
+    }
+
+    static FString Format(const FName& Value)
+    {
+        return Value.ToString();
+    }
+};
+
+/** Formats all the values on both sides and returns the nanoseconds per value
+ *  of the legacy and the new formatter. */
+template<typename TYPE>
+static void MeasureFormat(const TArray<TYPE>& Values, double& Out_LegacyNs,
+                          double& Out_NewNs)
+{
+    int32 Characters = 0;
+
+    FString Entry;
+    Entry.Reserve(TLOG_INLINE_BUFFER_SIZE);
+
+    const uint64 LegacyStart = FPlatformTime::Cycles64();
+
+    for (int32 Pass = 0; Pass < PASSES; ++Pass)
+    {
+        for (const TYPE& Value : Values)
+        {
+            Entry.Reset();
+            Entry += FTLegacyLogFormat::Format(Value);
+            Characters += Entry.Len();
+        }
+    }
+
+    const uint64 LegacyCycles = FPlatformTime::Cycles64() - LegacyStart;
+
+    TStringBuilder<TLOG_INLINE_BUFFER_SIZE> Buffer;
+
+    const uint64 NewStart = FPlatformTime::Cycles64();
+
+    for (int32 Pass = 0; Pass < PASSES; ++Pass)
+    {
+        for (const TYPE& Value : Values)
+        {
+            Buffer.Reset();
+            TLogString<TYPE>::Format(Value, Buffer);
+            Characters += Buffer.Len();
+        }
+    }
+
+    const uint64 NewCycles = FPlatformTime::Cycles64() - NewStart;
+
+    /* Keeps both loops from being optimized away. */
+    if (Characters == 0)
+    {
+        Out_LegacyNs = Out_NewNs = 0.0;
+        return;
+    }
+
+    const double Calls = static_cast<double>(PASSES * Values.Num());
+    Out_LegacyNs = FPlatformTime::ToSeconds64(LegacyCycles) * 1.0e9 / Calls;
+    Out_NewNs = FPlatformTime::ToSeconds64(NewCycles) * 1.0e9 / Calls;
+}
+
+/** Formats a value into a string through the new formatter. */
+template<typename TYPE>
+static FString FormatNew(const TYPE& Value)
+{
+    TStringBuilder<TLOG_INLINE_BUFFER_SIZE> Buffer;
+    TLogString<TYPE>::Format(Value, Buffer);
+    return FString(Buffer.Len(), Buffer.GetData());
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTLogFormatBenchmark,
+                                 "HideAndSeekWithAI.Benchmark.LogFormat",
+                                 LOG_FORMAT_FLAGS)
+
+bool FTLogFormatBenchmark::RunTest(const FString& Parameters)
+{
+    (void)Parameters;
+
+    const FTLogFormatSamples Samples(0x544C4F47);
+
+    /* The floating point values print differently than the legacy chains
+     * did; instead, they must read back to the very same value. */
+    for (int32 Index = 0; Index < SAMPLES; ++Index)
+    {
+        const FString Double(FormatNew(Samples.Doubles[Index]));
+        if (std::strtod(TCHAR_TO_ANSI(*Double), nullptr)
+                != Samples.Doubles[Index])
+        {
+            AddError(FString::Printf(TEXT("double '%s' does not round-trip!"),
+                                     *Double));
+            return false;
+        }
+
+        const FString Float(FormatNew(Samples.Floats[Index]));
+        if (std::strtof(TCHAR_TO_ANSI(*Float), nullptr)
+                != Samples.Floats[Index])
+        {
+            AddError(FString::Printf(TEXT("float '%s' does not round-trip!"),
+                                     *Float));
+            return false;
+        }
+    }
+
+    /* The rest must match what the legacy formatters produced. */
+    for (int32 Index = 0; Index < SAMPLES; ++Index)
+    {
+        const FString Expected[] = {
+            FTLegacyLogFormat::Format(Samples.Int32s[Index]),
+            FTLegacyLogFormat::Format(Samples.Int64s[Index]),
+            FTLegacyLogFormat::Format(Samples.Vectors[Index]),
+            FTLegacyLogFormat::Format(Samples.Rotators[Index]),
+            FTLegacyLogFormat::Format(Samples.Names[Index])
+        };
+        const FString Actual[] = {
+            FormatNew(Samples.Int32s[Index]),
+            FormatNew(Samples.Int64s[Index]),
+            FormatNew(Samples.Vectors[Index]),
+            FormatNew(Samples.Rotators[Index]),
+            FormatNew(Samples.Names[Index])
+        };
+
+        for (int32 Value = 0;
+             Value < static_cast<int32>(UE_ARRAY_COUNT(Expected)); ++Value)
+        {
+            if (!Actual[Value].Equals(Expected[Value], ESearchCase::CaseSensitive))
+            {
+                AddError(FString::Printf(TEXT("'%s' is not '%s'!"),
+                                         *Actual[Value], *Expected[Value]));
+                return false;
+            }
+        }
+    }
+
+    double LegacyNs = 0.0;
+    double NewNs = 0.0;
+
+    const auto Report = [this, &LegacyNs, &NewNs](const TCHAR* Type) {
+        AddInfo(FString::Printf(TEXT("%-8s legacy %7.1f ns, new %7.1f ns"
+                                     " (%.1fx)"),
+                                Type, LegacyNs, NewNs,
+                                NewNs > 0.0 ? LegacyNs / NewNs : 0.0));
+    };
+
+    MeasureFormat(Samples.Doubles, LegacyNs, NewNs);
+    Report(TEXT("double"));
+    MeasureFormat(Samples.Floats, LegacyNs, NewNs);
+    Report(TEXT("float"));
+    MeasureFormat(Samples.Int32s, LegacyNs, NewNs);
+    Report(TEXT("int32"));
+    MeasureFormat(Samples.Int64s, LegacyNs, NewNs);
+    Report(TEXT("int64"));
+    MeasureFormat(Samples.Vectors, LegacyNs, NewNs);
+    Report(TEXT("FVector"));
+    MeasureFormat(Samples.Rotators, LegacyNs, NewNs);
+    Report(TEXT("FRotator"));
+    MeasureFormat(Samples.Names, LegacyNs, NewNs);
+    Report(TEXT("FName"));
+
+    return true;
+}
+
+#endif  /* WITH_DEV_AUTOMATION_TESTS */